@@ -65,4 +65,76 @@ bool makeWindowTransparent(SDL_Window* window, COLORREF color_key) {
     // set colorkey
     return SetLayeredWindowAttributes(hWnd, color_key, 0, LWA_COLORKEY);
 
+}
+
+// Read only memory mapped file.
+class REGL_MappedFile{
+
+    public:
+
+        HANDLE file = INVALID_HANDLE_VALUE; // file handle
+        HANDLE mapping = NULL; // mapping handle
+        const char* data = NULL; // mapped data
+        size_t size = 0; // mapped size
+
+        // map a file, returns false if it can't be mapped
+        bool open(std::string path);
+
+        // unmap file
+        void close();
+
+        // destructor
+        ~REGL_MappedFile(){close();};
+
+};
+
+bool REGL_MappedFile::open(std::string path){
+
+    close();
+
+    // open file, allow others to keep writing to it
+    file = CreateFileA(
+        path.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE,
+        NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL
+    );
+    if (file == INVALID_HANDLE_VALUE){
+        return false;
+    }
+
+    // get size, empty files can't be mapped
+    LARGE_INTEGER file_size;
+    if (!GetFileSizeEx(file, &file_size) || !file_size.QuadPart){
+        close();
+        return false;
+    }
+    size = file_size.QuadPart;
+
+    // map file
+    mapping = CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL);
+    if (mapping){
+        data = (const char*) MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    }
+    if (!data){
+        close();
+        return false;
+    }
+
+    return true;
+
+}
+
+void REGL_MappedFile::close(){
+    if (data){
+        UnmapViewOfFile(data);
+    }
+    if (mapping){
+        CloseHandle(mapping);
+    }
+    if (file != INVALID_HANDLE_VALUE){
+        CloseHandle(file);
+    }
+    file = INVALID_HANDLE_VALUE;
+    mapping = NULL;
+    data = NULL;
+    size = 0;
 }
\ No newline at end of file
@@ -2,9 +2,13 @@
 #include <unordered_map>
 #include <vector>
 #include <string>
+#include <mutex>
+#include <fstream>
+#include <memory>
 
 #include "color.hpp"
 #include "sdl_functions.hpp"
+#include "extern_functions.hpp"
 
 #include "SDL2/include/SDL2/SDL.h"
 #include "SDL2/include/SDL2/SDL_image.h"
@@ -13,7 +17,9 @@
 #pragma once
 
 std::string _default_chars = " abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ1234567890!@#$%^&*()?.,[]{};:'\"/<>+=-_";
-TTF_Font* font;
+
+// Size of glyphs shown while the font loads in the background, relative to the full size.
+float _FONT_FALLBACK_SCALE = 0.1;
 
 // Character class for managing characters and their respective textures.
 class Character{
@@ -23,15 +29,32 @@ class Character{
         // dimensions
         float width;
         float height;
+        float advance = 0; // distance to the next character, can differ from width
 
         // texture
-        SDL_Texture* texture;
+        SDL_Texture* texture = NULL;
+
+        // texture size relative to the full glyph size, smaller for fallback glyphs
+        float texture_scale_x;
+        float texture_scale_y;
+
+        // position in the texture if the texture is a glyph atlas
+        int atlas_x = 0;
+        int atlas_y = 0;
+        bool owns_texture = true; // atlas textures are shared and not destroyed by characters
         
         // render function
         int render(SDL_Renderer* renderer, int x, int y, float size, SDL_Rect include_rect, REGL_Color color);
 
+        // replace texture, the surface is freed
+        void setTexture(SDL_Renderer* renderer, SDL_Surface* character_surf, float texture_scale_x = 1, float texture_scale_y = 1);
+
+        // replace texture with a glyph in a shared atlas texture
+        void setAtlasTexture(SDL_Texture* atlas_texture, int atlas_x, int atlas_y);
+
         // constructor
         Character(SDL_Renderer* renderer, SDL_Surface* character_surf);
+        Character(int surface_width, int surface_height);
         Character() = default;
 
 };
@@ -39,8 +62,39 @@ class Character{
 Character::Character(SDL_Renderer* renderer, SDL_Surface* character_surf){
 
     // store dimensions
-    width = character_surf->w / 20; // 1
-    height = character_surf->h / 20; // 1
+    width = character_surf->w / 20.0f; // 1
+    height = character_surf->h / 20.0f; // 1
+    advance = width;
+
+    // convert surface to texture
+    texture = NULL;
+    setTexture(renderer, character_surf);
+
+}
+
+Character::Character(int surface_width, int surface_height){
+
+    // store dimensions, texture is set later
+    width = surface_width / 20.0f;
+    height = surface_height / 20.0f;
+    advance = width;
+    texture = NULL;
+    texture_scale_x = 1;
+    texture_scale_y = 1;
+
+}
+
+void Character::setTexture(SDL_Renderer* renderer, SDL_Surface* character_surf, float texture_scale_x, float texture_scale_y){
+
+    // destroy old texture
+    if (texture && owns_texture){
+        SDL_DestroyTexture(texture);
+    }
+    this->texture_scale_x = texture_scale_x;
+    this->texture_scale_y = texture_scale_y;
+    atlas_x = 0;
+    atlas_y = 0;
+    owns_texture = true;
 
     // convert surface to texture
     texture = SDL_CreateTextureFromSurface(renderer, character_surf);
@@ -53,6 +107,21 @@ Character::Character(SDL_Renderer* renderer, SDL_Surface* character_surf){
 
 }
 
+void Character::setAtlasTexture(SDL_Texture* atlas_texture, int atlas_x, int atlas_y){
+
+    // destroy old texture
+    if (texture && owns_texture){
+        SDL_DestroyTexture(texture);
+    }
+    texture = atlas_texture;
+    texture_scale_x = 1;
+    texture_scale_y = 1;
+    this->atlas_x = atlas_x;
+    this->atlas_y = atlas_y;
+    owns_texture = false;
+
+}
+
 int Character::render(SDL_Renderer* renderer, int x, int y, float size, SDL_Rect include_rect, REGL_Color color){
 
     // get original rect
@@ -75,6 +144,16 @@ int Character::render(SDL_Renderer* renderer, int x, int y, float size, SDL_Rect
         int(size * height * crop_rect.h / 20 / height),
     };
 
+    // scale crop rect to texture size
+    crop_rect.x *= texture_scale_x;
+    crop_rect.y *= texture_scale_y;
+    crop_rect.w *= texture_scale_x;
+    crop_rect.h *= texture_scale_y;
+
+    // move crop rect to the glyph in the atlas
+    crop_rect.x += atlas_x;
+    crop_rect.y += atlas_y;
+
     // set color
     SDL_SetTextureColorMod(texture, color.r, color.g, color.b);
 
@@ -86,32 +165,637 @@ int Character::render(SDL_Renderer* renderer, int x, int y, float size, SDL_Rect
 
 }
 
-// Map of colors and maps of characters and their corresponding textures.
-std::unordered_map<std::string, Character> character_map;
+// Shaped string, positions are for size 1.
+class REGL_ShapedRun{
+
+    public:
+
+        std::vector<float> offsets; // x of each character, followed by the width of the string
+
+};
+
+// Shaped strings of a font in two generations. Strings found in the old generation move to the new one,
+// and the old generation is dropped when the new one is full, so strings in use are never shaped again.
+class _ShapedRunCache{
+
+    public:
+
+        std::unordered_map<std::string, std::shared_ptr<const REGL_ShapedRun>> current; // strings shaped or used in this generation
+        std::unordered_map<std::string, std::shared_ptr<const REGL_ShapedRun>> previous; // strings of the last generation
+
+};
+
+// Font class. Fonts keep their own characters, glyphs of all fonts share atlas pages.
+class REGL_Font{
+
+    public:
+
+        std::string font_file; // font file
+        TTF_Font* ttf = NULL; // opened font, NULL if loaded from the glyph cache
+        Character characters[256]; // characters by their byte
+        std::unordered_map<Uint16, float> kerning; // kerning of character pairs, key is previous character << 8 | character
+
+        // get a character
+        Character& getCharacter(char character){return characters[Uint8(character)];};
+
+        // get kerning between two characters
+        float getKerning(char previous, char character);
+
+        // load advances and kerning from the opened font
+        void loadMetrics(std::string characters);
+
+        // shape a string, shaped strings are cached per thread
+        std::shared_ptr<const REGL_ShapedRun> shape(const std::string& text);
+
+        // place characters of a string without caching, offsets get the x of each character followed by the width
+        void place(const std::string& text, std::vector<float>& offsets);
+
+};
+
+float REGL_Font::getKerning(char previous, char character){
+    if (kerning.empty()){
+        return 0;
+    }
+    auto found = kerning.find(Uint16(Uint8(previous) << 8 | Uint8(character)));
+    return (found != kerning.end()) ? found->second : 0;
+}
+
+void REGL_Font::loadMetrics(std::string characters){
+
+    // fractional advances, glyphs are rasterized 20 times bigger than size 1
+    for (char& character: characters){
+        int min_x, max_x, min_y, max_y, advance;
+        if (TTF_GlyphMetrics(ttf, Uint8(character), &min_x, &max_x, &min_y, &max_y, &advance) == 0){
+            getCharacter(character).advance = advance / 20.0f;
+        }
+    }
+
+    // keep only pairs with kerning
+    kerning.clear();
+    for (char& previous: characters){
+        for (char& character: characters){
+            int amount = TTF_GetFontKerningSizeGlyphs(ttf, Uint8(previous), Uint8(character));
+            if (amount){
+                kerning[Uint16(Uint8(previous) << 8 | Uint8(character))] = amount / 20.0f;
+            }
+        }
+    }
+
+}
+
+// Shaped strings of each font. Layout threads shape too, so each thread keeps its own and shaping doesn't lock.
+thread_local std::unordered_map<const REGL_Font*, _ShapedRunCache> _shaped_run_caches;
+
+std::shared_ptr<const REGL_ShapedRun> REGL_Font::shape(const std::string& text){
+
+    // check if shaped in this generation
+    _ShapedRunCache& cache = _shaped_run_caches[this];
+    auto found = cache.current.find(text);
+    if (found != cache.current.end()){
+        return found->second;
+    }
+
+    // take it from the last generation, otherwise place characters with advances and kerning
+    std::shared_ptr<const REGL_ShapedRun> shaped_run;
+    auto old_found = cache.previous.find(text);
+    if (old_found != cache.previous.end()){
+        shaped_run = std::move(old_found->second);
+        cache.previous.erase(old_found);
+    } else {
+        std::shared_ptr<REGL_ShapedRun> placed_run = std::make_shared<REGL_ShapedRun>();
+        place(text, placed_run->offsets);
+        shaped_run = std::move(placed_run);
+    }
+
+    // start a new generation if full, strings not used in the last one are dropped, runs in use are kept alive by their users
+    if (cache.current.size() >= REGL_SHAPED_RUN_CACHE_SIZE){
+        cache.previous.swap(cache.current);
+        cache.current.clear();
+    }
+    cache.current.emplace(text, shaped_run);
+    return shaped_run;
+
+}
+
+void REGL_Font::place(const std::string& text, std::vector<float>& offsets){
+    offsets.resize(text.size() + 1);
+    float pen_x = 0;
+    for (size_t index = 0; index < text.size(); index ++){
+        if (index){
+            pen_x += getKerning(text[index - 1], text[index]);
+        }
+        offsets[index] = pen_x;
+        pen_x += getCharacter(text[index]).advance;
+    }
+    offsets[text.size()] = pen_x;
+}
+
+// Loaded fonts by file.
+std::unordered_map<std::string, std::unique_ptr<REGL_Font>> _loaded_fonts;
+
+// Font used if no font is given, the first loaded font.
+REGL_Font* regl_default_font = NULL;
+
+// Used for characters if no font is loaded.
+Character _missing_character;
+
+// Get a character of a font or the default font. Doesn't change anything, so layout threads can use it.
+Character& getCharacter(char character, REGL_Font* font = NULL){
+    if (!font){
+        font = regl_default_font;
+    }
+    return (font) ? font->getCharacter(character) : _missing_character;
+}
+
+// Glyph rasterized in the background, waiting to be uploaded on the render thread.
+class _RasterizedGlyph{
+
+    public:
+
+        REGL_Font* font; // font of the glyph
+        char character; // character
+        std::vector<Uint8> alpha; // glyph alpha
+        int width, height; // glyph dimensions
+
+};
+
+std::vector<_RasterizedGlyph> _rasterized_glyphs;
+std::mutex _rasterized_glyphs_mutex;
+
+// Atlas page shared by the glyphs of all fonts.
+class _GlyphPage{
+
+    public:
+
+        SDL_Texture* texture; // page texture
+        int x = 0; // x of next glyph in current row
+        int row_y = 0; // y of current row
+        int row_height = 0; // height of current row
+
+};
+
+// Dimensions of glyph pages.
+const int _GLYPH_PAGE_WIDTH = 4096;
+const int _GLYPH_PAGE_HEIGHT = 2048;
+
+// Glyph pages, glyphs are added to the last page.
+std::vector<_GlyphPage> _glyph_pages;
+
+// Width of glyph atlases in the glyph cache.
+const int _GLYPH_ATLAS_WIDTH = 4096;
+
+// Get alpha of a rasterized glyph, glyphs are rendered in white.
+std::vector<Uint8> surfaceAlpha(SDL_Surface* character_surf){
+
+    std::vector<Uint8> glyph_alpha(character_surf->w * character_surf->h);
+    SDL_LockSurface(character_surf);
+    for (int row = 0; row < character_surf->h; row ++){
+        Uint32* pixels = (Uint32*) ((Uint8*) character_surf->pixels + row * character_surf->pitch);
+        for (int column = 0; column < character_surf->w; column ++){
+            Uint8 r, g, b, a;
+            SDL_GetRGBA(pixels[column], character_surf->format, &r, &g, &b, &a);
+            glyph_alpha[row * character_surf->w + column] = a;
+        }
+    }
+    SDL_UnlockSurface(character_surf);
+
+    return glyph_alpha;
+
+}
+
+// Upload alpha of a glyph into the glyph pages and point a character to it.
+void uploadGlyph(SDL_Renderer* renderer, Character& character, const Uint8* alpha, int pitch, int width, int height){
+
+    // go to next row if it doesn't fit in the current row
+    _GlyphPage* page = (_glyph_pages.empty()) ? NULL : &_glyph_pages.back();
+    if (page && page->x + width > _GLYPH_PAGE_WIDTH){
+        page->x = 0;
+        page->row_y += page->row_height + 1;
+        page->row_height = 0;
+    }
+
+    // create a new page if it doesn't fit in the current page, the character keeps its texture if the page can't be created
+    if (!page || page->row_y + height > _GLYPH_PAGE_HEIGHT){
+        _GlyphPage new_page;
+        new_page.texture = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_ARGB8888, SDL_TEXTUREACCESS_STATIC, _GLYPH_PAGE_WIDTH, _GLYPH_PAGE_HEIGHT);
+        if (!new_page.texture){
+            std::cout << "Unable to create glyph page: " << SDL_GetError() << "\n";
+            return;
+        }
+        SDL_SetTextureBlendMode(new_page.texture, SDL_BLENDMODE_BLEND);
+        _glyph_pages.push_back(new_page);
+        page = &_glyph_pages.back();
+    }
+
+    // upload glyph in white
+    SDL_Rect glyph_rect = {page->x, page->row_y, width, height};
+    std::vector<Uint32> glyph_pixels(size_t(width) * height);
+    for (int row = 0; row < height; row ++){
+        for (int column = 0; column < width; column ++){
+            glyph_pixels[row * width + column] = (Uint32(alpha[size_t(row) * pitch + column]) << 24) | 0xFFFFFF;
+        }
+    }
+    SDL_UpdateTexture(page->texture, &glyph_rect, glyph_pixels.data(), width * sizeof(Uint32));
+
+    // move to next position, leave a pixel between glyphs
+    page->x += width + 1;
+    page->row_height = regl_max(page->row_height, height);
+
+    // keep advance, it comes from the font metrics, the old texture is destroyed if the character owns it
+    character.width = width / 20.0f;
+    character.height = height / 20.0f;
+    if (!character.advance){
+        character.advance = character.width;
+    }
+    character.setAtlasTexture(page->texture, glyph_rect.x, glyph_rect.y);
+
+}
+
+// Glyph cache file header.
+class _GlyphCacheHeader{
+
+    public:
+
+        char magic[4]; // always RGLC
+        Uint32 version; // cache format version
+        Uint64 key; // hash of font file, raster size and characters
+        Uint32 glyph_count; // number of glyphs
+        Uint32 kerning_count; // number of kerning pairs
+        Uint32 atlas_width, atlas_height; // atlas dimensions
+
+};
+
+// Glyph cache file record of a glyph.
+class _GlyphCacheRecord{
+
+    public:
+
+        Uint32 character; // character
+        SDL_Rect rect; // position in the atlas
+        float advance; // advance of the character
+
+};
+
+// Glyph cache file record of a kerning pair.
+class _GlyphCacheKerning{
+
+    public:
+
+        Uint32 pair; // previous character << 8 | character
+        float amount; // kerning
+
+};
+
+// Version of the glyph cache format, change this when the format changes.
+const Uint32 _GLYPH_CACHE_VERSION = 2;
+
+// Rasterized glyphs packed into one alpha atlas.
+class _GlyphAtlas{
+
+    public:
+
+        std::vector<_GlyphCacheRecord> records; // glyphs
+        std::vector<_GlyphCacheKerning> kerning_pairs; // kerning pairs
+        std::vector<std::vector<Uint8>> glyph_alphas; // alpha of each glyph before packing
+        std::vector<Uint8> alpha; // packed alpha
+        int width = _GLYPH_ATLAS_WIDTH; // atlas width
+        int height = 0; // atlas height
+
+        // add alpha of a rasterized glyph
+        void add(char character, std::vector<Uint8> glyph_alpha, int width, int height, float advance);
+
+        // store kerning of a font
+        void setKerning(REGL_Font* font);
+
+        // pack added glyphs into the atlas
+        void pack();
+
+        // write atlas to a cache file
+        void save(std::string path, Uint64 key);
+
+};
+
+void _GlyphAtlas::add(char character, std::vector<Uint8> glyph_alpha, int width, int height, float advance){
+    records.push_back({Uint32(Uint8(character)), {0, 0, width, height}, advance});
+    glyph_alphas.push_back(std::move(glyph_alpha));
+}
+
+void _GlyphAtlas::setKerning(REGL_Font* font){
+    kerning_pairs.clear();
+    for (auto& [pair, amount]: font->kerning){
+        kerning_pairs.push_back({pair, amount});
+    }
+}
+
+void _GlyphAtlas::pack(){
+
+    // place glyphs in rows, leave a pixel between glyphs
+    int x = 0, row_y = 0, row_height = 0;
+    for (_GlyphCacheRecord& record: records){
+        if (x + record.rect.w > width){
+            x = 0;
+            row_y += row_height + 1;
+            row_height = 0;
+        }
+        record.rect.x = x;
+        record.rect.y = row_y;
+        x += record.rect.w + 1;
+        row_height = regl_max(row_height, record.rect.h);
+    }
+    height = row_y + row_height;
+
+    // copy glyphs into atlas
+    alpha.assign(size_t(width) * height, 0);
+    for (size_t index = 0; index < records.size(); index ++){
+        SDL_Rect& rect = records[index].rect;
+        for (int row = 0; row < rect.h; row ++){
+            std::copy(
+                glyph_alphas[index].begin() + row * rect.w, glyph_alphas[index].begin() + (row + 1) * rect.w,
+                alpha.begin() + size_t(rect.y + row) * width + rect.x
+            );
+        }
+    }
+    glyph_alphas.clear();
+
+}
 
-// Load a font file and edit the character map accordingly.
-void loadFont(
+void _GlyphAtlas::save(std::string path, Uint64 key){
+
+    std::ofstream cache_file(path, std::ios::binary | std::ios::trunc);
+    if (!cache_file){
+        return;
+    }
+
+    _GlyphCacheHeader header = {
+        {'R', 'G', 'L', 'C'}, _GLYPH_CACHE_VERSION, key,
+        Uint32(records.size()), Uint32(kerning_pairs.size()), Uint32(width), Uint32(height)
+    };
+    cache_file.write((const char*) &header, sizeof(header));
+    cache_file.write((const char*) records.data(), records.size() * sizeof(_GlyphCacheRecord));
+    cache_file.write((const char*) kerning_pairs.data(), kerning_pairs.size() * sizeof(_GlyphCacheKerning));
+    cache_file.write((const char*) alpha.data(), alpha.size());
+
+}
+
+// Hash a font file, raster size and characters for the glyph cache.
+Uint64 glyphCacheKey(REGL_MappedFile& font_data, int raster_size, std::string characters){
+
+    // fnv-1a
+    Uint64 key = 14695981039346656037ULL;
+    auto hash_bytes = [&key](const char* bytes, size_t size){
+        for (size_t index = 0; index < size; index ++){
+            key = (key ^ Uint8(bytes[index])) * 1099511628211ULL;
+        }
+    };
+    hash_bytes(font_data.data, font_data.size);
+    hash_bytes((const char*) &raster_size, sizeof(raster_size));
+    hash_bytes(characters.data(), characters.size());
+
+    return key;
+
+}
+
+// Load glyphs from a glyph cache file, returns false if there is no valid cache.
+bool loadGlyphCache(SDL_Renderer* renderer, REGL_Font* font, std::string path, Uint64 key){
+
+    REGL_MappedFile cache_file;
+    if (!cache_file.open(path) || cache_file.size < sizeof(_GlyphCacheHeader)){
+        return false;
+    }
+
+    // check header
+    const _GlyphCacheHeader* header = (const _GlyphCacheHeader*) cache_file.data;
+    size_t expected_size = sizeof(_GlyphCacheHeader)
+        + size_t(header->glyph_count) * sizeof(_GlyphCacheRecord)
+        + size_t(header->kerning_count) * sizeof(_GlyphCacheKerning)
+        + size_t(header->atlas_width) * header->atlas_height;
+    if (
+        std::string(header->magic, 4) != "RGLC" || header->version != _GLYPH_CACHE_VERSION
+        || header->key != key || cache_file.size != expected_size
+    ){
+        return false;
+    }
+
+    // upload glyphs straight from the mapped file
+    const _GlyphCacheRecord* records = (const _GlyphCacheRecord*) (cache_file.data + sizeof(_GlyphCacheHeader));
+    const _GlyphCacheKerning* kerning_pairs = (const _GlyphCacheKerning*) (records + header->glyph_count);
+    const Uint8* alpha = (const Uint8*) (kerning_pairs + header->kerning_count);
+    for (Uint32 index = 0; index < header->glyph_count; index ++){
+        const SDL_Rect& rect = records[index].rect;
+        Character& loaded_character = font->characters[Uint8(records[index].character)];
+        loaded_character.advance = records[index].advance;
+        uploadGlyph(
+            renderer, loaded_character,
+            alpha + size_t(rect.y) * header->atlas_width + rect.x, header->atlas_width,
+            rect.w, rect.h
+        );
+    }
+    for (Uint32 index = 0; index < header->kerning_count; index ++){
+        font->kerning[Uint16(kerning_pairs[index].pair)] = kerning_pairs[index].amount;
+    }
+
+    return true;
+
+}
+
+// Load a font file. Fonts that were loaded before are returned without loading again.
+// If loaded in the background, small fallback glyphs are shown until the full glyphs are uploaded.
+REGL_Font* loadFont(
     SDL_Renderer* renderer,
     std::string font_file,
-    std::string characters = _default_chars
+    std::string characters = _default_chars,
+    bool background = false
 ){
 
+    // check if loaded
+    std::unique_ptr<REGL_Font>& loaded_font = _loaded_fonts[font_file];
+    if (loaded_font){
+        return loaded_font.get();
+    }
+    loaded_font = std::make_unique<REGL_Font>();
+    REGL_Font* font = loaded_font.get();
+    font->font_file = font_file;
+
+    // first font is the default font
+    if (!regl_default_font){
+        regl_default_font = font;
+    }
+
+    // use glyph cache if the font was rasterized before
+    std::string cache_path;
+    Uint64 cache_key = 0;
+    REGL_MappedFile font_data;
+    if (font_data.open(font_file)){
+        cache_key = glyphCacheKey(font_data, 500, characters);
+        char key_str[17];
+        snprintf(key_str, sizeof(key_str), "%016llx", (unsigned long long) cache_key);
+        cache_path = font_file + "." + key_str + ".glyphs";
+        font_data.close();
+        if (loadGlyphCache(renderer, font, cache_path, cache_key)){
+            return font;
+        }
+    }
+
     // load font
-    font = TTF_OpenFont(font_file.c_str(), 500); // 30
+    font->ttf = TTF_OpenFont(font_file.c_str(), 500); // 30
+    if (font->ttf){
+        font->loadMetrics(characters);
+    }
 
     // render text in black
     SDL_Color color = {255, 255, 255};
 
-    // store each character
+    if (!background){
+
+        // rasterize each character
+        _GlyphAtlas atlas;
+        for (char& character: characters){
+            
+            std::string char_str(1, character);
+            SDL_Surface* character_surf = TTF_RenderText_Blended(font->ttf, char_str.c_str(), color);
+            if (character_surf){
+                std::vector<Uint8> glyph_alpha = surfaceAlpha(character_surf);
+                uploadGlyph(renderer, font->getCharacter(character), glyph_alpha.data(), character_surf->w, character_surf->w, character_surf->h);
+                atlas.add(character, std::move(glyph_alpha), character_surf->w, character_surf->h, font->getCharacter(character).advance);
+                SDL_FreeSurface(character_surf);
+            }
+            
+        }
+
+        // cache glyphs for the next start
+        if (!cache_path.empty()){
+            atlas.setKerning(font);
+            atlas.pack();
+            atlas.save(cache_path, cache_key);
+        }
+
+        return font;
+
+    }
+
+    // store dimensions of each character without rasterizing, so layout doesn't change when glyphs arrive
     for (char& character: characters){
-        
         std::string char_str(1, character);
-        character_map[char_str] = Character(renderer, TTF_RenderText_Blended(font, char_str.c_str(), color));
-        
+        int surface_width, surface_height;
+        TTF_SizeText(font->ttf, char_str.c_str(), &surface_width, &surface_height);
+        Character& loaded_character = font->getCharacter(character);
+        float advance = loaded_character.advance;
+        loaded_character = Character(surface_width, surface_height);
+        loaded_character.advance = (advance) ? advance : loaded_character.width;
+    }
+
+    // rasterize small fallback glyphs for the first frames
+    TTF_Font* fallback_font = TTF_OpenFont(font_file.c_str(), 500 * _FONT_FALLBACK_SCALE);
+    for (char& character: characters){
+        std::string char_str(1, character);
+        SDL_Surface* character_surf = TTF_RenderText_Blended(fallback_font, char_str.c_str(), color);
+        Character& loaded_character = font->getCharacter(character);
+        if (character_surf){
+            loaded_character.setTexture(
+                renderer, character_surf,
+                character_surf->w / regl_max(loaded_character.width * 20, 1.0f),
+                character_surf->h / regl_max(loaded_character.height * 20, 1.0f)
+            );
+        }
     }
+    TTF_CloseFont(fallback_font);
+
+    // rasterize full glyphs in the background, the render thread doesn't use the font until done
+    reglThreadPool().submit([font, characters, color, cache_path, cache_key]{
+
+        _GlyphAtlas atlas;
+        for (char character: characters){
+            std::string char_str(1, character);
+            SDL_Surface* character_surf = TTF_RenderText_Blended(font->ttf, char_str.c_str(), color);
+            if (!character_surf){
+                continue;
+            }
+            std::vector<Uint8> glyph_alpha = surfaceAlpha(character_surf);
+            {
+                std::lock_guard<std::mutex> lock(_rasterized_glyphs_mutex);
+                _rasterized_glyphs.push_back({font, character, glyph_alpha, character_surf->w, character_surf->h});
+            }
+            atlas.add(character, std::move(glyph_alpha), character_surf->w, character_surf->h, font->getCharacter(character).advance);
+            SDL_FreeSurface(character_surf);
+        }
+
+        // cache glyphs for the next start
+        if (!cache_path.empty()){
+            atlas.setKerning(font);
+            atlas.pack();
+            atlas.save(cache_path, cache_key);
+        }
+
+    });
+
+    return font;
     
 }
 
+// Upload glyphs rasterized in the background, at most REGL_TEXTURE_UPLOAD_BUDGET bytes per call.
+// Call this when no layout is running, it changes characters.
+void uploadRasterizedGlyphs(SDL_Renderer* renderer){
+
+    std::lock_guard<std::mutex> lock(_rasterized_glyphs_mutex);
+
+    size_t uploaded_count = 0;
+    int uploaded_bytes = 0;
+    for (; uploaded_count < _rasterized_glyphs.size(); uploaded_count ++){
+
+        _RasterizedGlyph& glyph = _rasterized_glyphs[uploaded_count];
+
+        // stop if over budget, always upload at least one
+        int glyph_bytes = glyph.width * glyph.height * sizeof(Uint32);
+        if (uploaded_count && uploaded_bytes + glyph_bytes > REGL_TEXTURE_UPLOAD_BUDGET){
+            break;
+        }
+        uploaded_bytes += glyph_bytes;
+
+        // replace fallback glyph
+        uploadGlyph(renderer, glyph.font->getCharacter(glyph.character), glyph.alpha.data(), glyph.width, glyph.width, glyph.height);
+
+    }
+
+    // remove uploaded glyphs
+    _rasterized_glyphs.erase(_rasterized_glyphs.begin(), _rasterized_glyphs.begin() + uploaded_count);
+
+}
+
+// Shape text with a font or the default font, NULL if no font is loaded.
+std::shared_ptr<const REGL_ShapedRun> shapeText(const std::string& text, REGL_Font* font = NULL){
+    if (!font){
+        font = regl_default_font;
+    }
+    return (font) ? font->shape(text) : NULL;
+}
+
+// Place characters of text with a font or the default font without caching, for text that changes often.
+void placeText(const std::string& text, std::vector<float>& offsets, REGL_Font* font = NULL){
+    if (!font){
+        font = regl_default_font;
+    }
+    if (font){
+        font->place(text, offsets);
+    } else {
+        offsets.assign(text.size() + 1, 0);
+    }
+}
+
+// Render text with offsets from placeText.
+void renderPlacedText(
+    SDL_Renderer* renderer,
+    REGL_Color color,
+    const std::string& text, const std::vector<float>& offsets,
+    int x, int y,
+    float size,
+    SDL_Rect include_rect = _FILL_RECT_ALL,
+    REGL_Font* font = NULL
+){
+    for (size_t index = 0; index < text.size(); index ++){
+        getCharacter(text[index], font).render(renderer, x + int(offsets[index] * size + 0.5f), y, size, include_rect, color);
+    }
+}
+
 // Render text.
 void renderText(
     SDL_Renderer* renderer,
@@ -119,44 +803,47 @@ void renderText(
     std::string text,
     int x, int y,
     float size, float max = 10000,
-    SDL_Rect include_rect = _FILL_RECT_ALL
+    SDL_Rect include_rect = _FILL_RECT_ALL,
+    REGL_Font* font = NULL
 ){
 
-    int original_x = x;
+    std::shared_ptr<const REGL_ShapedRun> shaped_run = shapeText(text, font);
+    if (!shaped_run){return;}
 
-    // render characters
-    for (char& character: text){
-
-        std::string char_str(1, character);
-        x += character_map[char_str].render(renderer, x, y, size, include_rect, color);
+    // render characters at their shaped positions
+    for (size_t index = 0; index < text.size(); index ++){
 
         // check if more than max width?
-        if (x - original_x >= max){
+        float offset = shaped_run->offsets[index] * size;
+        if (offset >= max){
             return;
         }
 
+        getCharacter(text[index], font).render(renderer, x + int(offset + 0.5f), y, size, include_rect, color);
+
     }
 
 }
 
 // Get width of text to be rendered.
-float textWidth(std::string text, float size, float max = 10000){
+float textWidth(std::string text, float size, float max = 10000, REGL_Font* font = NULL){
 
     if (!text.size()){return 0;}
 
-    float width = 0;
-
-    // go through widths
-    for (char& character: text){
+    std::shared_ptr<const REGL_ShapedRun> shaped_run = shapeText(text, font);
+    if (!shaped_run){return 0;}
 
-        std::string char_str(1, character);
-        width += character_map[char_str].width * size;
+    // usually the whole text fits
+    float width = shaped_run->offsets.back() * size;
+    if (width < max){
+        return width;
+    }
 
-        // check if width exceeded max
-        if (width >= max){
-            return width;
+    // width up to the character that exceeded max
+    for (size_t index = 1; index < shaped_run->offsets.size(); index ++){
+        if (shaped_run->offsets[index] * size >= max){
+            return shaped_run->offsets[index] * size;
         }
-
     }
 
     return width;
@@ -164,7 +851,7 @@ float textWidth(std::string text, float size, float max = 10000){
 }
 
 // Get last character before text wrap.
-int textWrapIndex(std::string text, float size, float max = 10000, bool wrap_by_words = false){
+int textWrapIndex(std::string text, float size, float max = 10000, bool wrap_by_words = false, REGL_Font* font = NULL){
 
     if (!text.size()){return 0;}
 
@@ -173,20 +860,25 @@ int textWrapIndex(std::string text, float size, float max = 10000, bool wrap_by_
     // last space (for wrapping by words)
     int last_space_index = -1;
 
+    // not shaped with the cache, wrapping measures many different substrings
+    REGL_Font* kerning_font = (font) ? font : regl_default_font;
+
     // go through widths
     int index = 0;
     for (char& character: text){
 
-        std::string char_str(1, character);
-        width += character_map[char_str].width * size;
+        if (index && kerning_font){
+            width += kerning_font->getKerning(text[index - 1], character) * size;
+        }
+        width += getCharacter(character, font).advance * size;
 
         // check if is a space
-        if (char_str == " "){
+        if (character == ' '){
             last_space_index = index;
         }
 
         // check if is newline
-        if (char_str == "\n"){
+        if (character == '\n'){
             return index + 1;
         }
 
@@ -204,11 +896,11 @@ int textWrapIndex(std::string text, float size, float max = 10000, bool wrap_by_
 }
 
 // Get height of text to be rendered.
-float textHeight(std::string text, float size){
+float textHeight(std::string text, float size, REGL_Font* font = NULL){
 
     if (!text.size()){return 0;}
 
     // all characters have the same height
-    return character_map[text.substr(0, 1)].height * size;
+    return getCharacter(text[0], font).height * size;
 
 }
\ No newline at end of file
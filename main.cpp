@@ -20,6 +20,11 @@ int main(int argc, char* argv[]){
         10, REGL_COLOR_WHITE
     );
 
+    // get scene ids
+    int demo_scene = information_window->sceneId("DEMO");
+    int coming_next_scene = information_window->sceneId("COMING_NEXT");
+    int default_scene = information_window->sceneId(REGL_SCENE_DEFAULT);
+
     // add text
     addText(
         information_window, REGL_SCENE_DEFAULT,
@@ -45,7 +50,7 @@ int main(int argc, char* argv[]){
         information_window, REGL_SCENE_DEFAULT,
         "Show me more!", REGL_COLOR_BLACK, 0.7,
         REGL_COLOR_BLACK, 5,
-        [&information_window]{information_window->current_scene = "DEMO";},
+        [&information_window, demo_scene]{information_window->switchScene(demo_scene);},
         200, 70,
         100, 10,
         15,
@@ -56,7 +61,7 @@ int main(int argc, char* argv[]){
         information_window, REGL_SCENE_DEFAULT,
         "What's coming next?", REGL_COLOR_BLACK, 0.7,
         REGL_COLOR_BLACK, 5,
-        [&information_window]{information_window->current_scene = "COMING_NEXT";},
+        [&information_window, coming_next_scene]{information_window->switchScene(coming_next_scene);},
         200, 70,
         REGL_NEXTLINE_DEFAULT, 10,
         15,
@@ -67,7 +72,7 @@ int main(int argc, char* argv[]){
         information_window, "DEMO",
         "Back", REGL_COLOR_BLACK, 0.7,
         REGL_COLOR_BLACK, 5,
-        [&information_window]{information_window->current_scene = REGL_SCENE_DEFAULT;},
+        [&information_window, default_scene]{information_window->switchScene(default_scene);},
         200, 70,
         100, 10,
         15,
@@ -78,7 +83,7 @@ int main(int argc, char* argv[]){
         information_window, "COMING_NEXT",
         "Back", REGL_COLOR_BLACK, 0.7,
         REGL_COLOR_BLACK, 5,
-        [&information_window]{information_window->current_scene = REGL_SCENE_DEFAULT;},
+        [&information_window, default_scene]{information_window->switchScene(default_scene);},
         200, 70,
         100, 10,
         15,
@@ -57,6 +57,151 @@ REGL_Checkbox* addCheckbox(
     REGL_Color color, REGL_Color checked_color,
     REGL_Color tick_color
 );
+REGL_Checkbox* addCheckbox(
+    REGL_Window* window, std::string scene_name,
+    REGL_Observable<bool>& observable_checked,
+    std::function<void()> on_click,
+    int width, int nextline, int indent, int edge_radius,
+    REGL_Color outline_color, float outline_width,
+    REGL_Color color, REGL_Color checked_color,
+    REGL_Color tick_color
+);
+
+// Add REGL_ListView to a window.
+REGL_ListView* addListView(
+    REGL_Window* window, std::string scene_name,
+    std::function<int()> row_count,
+    std::function<std::string(int)> row_at,
+    std::function<int(int)> row_height_at,
+    std::function<void(int)> on_click,
+    int width, int row_height,
+    float text_size, REGL_Color text_color, REGL_Color selected_color,
+    int nextline, int indent
+);
+
+// Add REGL_Plot to a window.
+REGL_Plot* addPlot(
+    REGL_Window* window, std::string scene_name,
+    size_t capacity,
+    int width, int height,
+    REGL_Color line_color, REGL_Color background_color,
+    int nextline, int indent
+);
+
+// Add REGL_TextInput to a window.
+REGL_TextInput* addTextInput(
+    REGL_Window* window, std::string scene_name,
+    std::string initial_text, bool multiline,
+    int width, int height,
+    float text_size, REGL_Color text_color, REGL_Color background_color,
+    REGL_Color caret_color, REGL_Color selection_color,
+    std::function<void()> on_change,
+    int nextline, int indent
+);
+
+// Add REGL_Table to a window.
+REGL_Table* addTable(
+    REGL_Window* window, std::string scene_name,
+    std::vector<std::string> column_names, std::vector<int> column_widths,
+    std::function<int()> row_count,
+    std::function<std::string(int, int)> cell_at,
+    std::function<void(int)> on_click,
+    int width, int row_height,
+    float text_size, REGL_Color text_color, REGL_Color header_color, REGL_Color selected_color,
+    int nextline, int indent
+);
+
+// Add REGL_TreeView to a window.
+REGL_TreeView* addTreeView(
+    REGL_Window* window, std::string scene_name,
+    Uint64 root,
+    std::function<std::vector<Uint64>(Uint64)> children_of,
+    std::function<std::string(Uint64)> node_text,
+    std::function<bool(Uint64)> has_children,
+    std::function<void(Uint64)> on_click,
+    int width, int row_height, int indent_width,
+    float text_size, REGL_Color text_color, REGL_Color selected_color,
+    int nextline, int indent
+);
+
+// Add REGL_Image to a window.
+REGL_Image* addImage(
+    REGL_Window* window, std::string scene_name,
+    std::string path,
+    int width, int height,
+    int nextline, int indent
+);
+
+// Add REGL_Canvas to a window.
+REGL_Canvas* addCanvas(
+    REGL_Window* window, std::string scene_name,
+    int canvas_width, int canvas_height,
+    int width, int height,
+    int nextline, int indent
+);
+
+// Add REGL_LogView to a window.
+REGL_LogView* addLogView(
+    REGL_Window* window, std::string scene_name,
+    std::string path,
+    int width, int height,
+    float text_size, REGL_Color text_color, REGL_Color background_color,
+    int nextline, int indent
+);
+
+// Add REGL_ProgressBar to a window.
+REGL_ProgressBar* addProgressBar(
+    REGL_Window* window, std::string scene_name,
+    int width, int height, int edge_radius,
+    REGL_Color track_color, REGL_Color fill_color,
+    int nextline, int indent
+);
+
+// Add REGL_Gauge to a window.
+REGL_Gauge* addGauge(
+    REGL_Window* window, std::string scene_name,
+    int radius, int thickness,
+    REGL_Color track_color, REGL_Color fill_color,
+    int nextline, int indent
+);
+
+// Add REGL_Slider to a window.
+REGL_Slider* addSlider(
+    REGL_Window* window, std::string scene_name,
+    float min_value, float max_value, float initial_value, float step,
+    int width, int height,
+    REGL_Color track_color, REGL_Color fill_color, REGL_Color thumb_color,
+    std::function<void(float)> on_change,
+    int nextline, int indent
+);
+
+// Add REGL_Dropdown to a window.
+REGL_Dropdown* addDropdown(
+    REGL_Window* window, std::string scene_name,
+    std::vector<std::string> options,
+    std::function<void(int)> on_select,
+    int width, int row_height, int visible_rows,
+    float text_size, REGL_Color text_color, REGL_Color background_color, REGL_Color highlight_color,
+    int nextline, int indent
+);
+
+// Run a function on the render thread at the start of the next frame. Safe to call from any thread.
+void reglPost(std::function<void()> function);
+
+// Same as above, but only the newest function posted with the same key is run.
+void reglPost(const void* key, std::function<void()> function);
+
+// Change text of a REGL_Text from any thread. The text must not be destroyed before the next frame.
+void postText(REGL_Text* text, std::string new_text);
+
+// Enable or disable a child object from any thread. The child object must not be destroyed before the next frame.
+void postEnabled(REGL_ChildObject* child_object, bool enabled);
+
+// Switch scene of a window from any thread.
+void postSwitchScene(REGL_Window* window, int scene_id);
+
+// Remove all child objects from a scene of a window. They are destroyed at the start of the next frame, so this can be called from their callbacks.
+void clearScene(REGL_Window* window, std::string scene_name);
 
 // Close all SDL2 things.
 void reglQuit();
@@ -69,7 +214,9 @@ SDL_Window* regl_window;
 SDL_Renderer* regl_renderer;
 
 // SDL Cursors.
-std::unordered_map<std::string, SDL_Cursor*> regl_cursors;
+SDL_Cursor* regl_cursors[_REGL_CURSOR_COUNT];
+REGL_Cursor requested_cursor = REGL_CURSOR_DEFAULT; // cursor requested this frame
+REGL_Cursor _shown_cursor = _REGL_CURSOR_COUNT; // cursor currently set
 
 // FPS Capping.
 const int _FPS = 60;
@@ -78,22 +225,38 @@ Uint32 _framestart;
 int _frametime;
 
 // Update variables.
-bool mouse_clicked, sent_mouse_clicked;
-bool mouse_held, sent_mouse_held;
-bool mouse_up, sent_mouse_up;
-bool sent_hovered;
+bool mouse_clicked;
+bool mouse_held;
+bool mouse_up;
 int scrolled;
-bool sent_scrolled;
 int top_index;
 
+// Events of the current frame.
+std::vector<REGL_Event> regl_events;
+
+// Last clicked object, gets key and text events.
+REGL_Object* focused_object = NULL;
+
 // Mouse position.
 SDL_Rect mouse_rect;
 
 // REGL Objects
 std::vector<std::unique_ptr<REGL_Object>> ui_objects;
 
+// Objects drawn above all REGL Objects and hit tested first, like dropdown popups. Not owned.
+std::vector<REGL_Object*> regl_overlays;
+
+// Scenes with cleared child objects to destroy at the start of the next frame.
+std::vector<REGL_Scene*> regl_cleared_scenes;
+
+// Commands posted from other threads.
+REGL_CommandQueue regl_command_queue;
+
+// Layout tasks of objects.
+REGL_TaskGroup _layout_tasks;
+
 // Initialize SDL2.
-void reglInit(bool create_exit_window = true, Uint32 renderer_flags = REGL_RENDER_SOFTWARE){
+void reglInit(bool create_exit_window = true, Uint32 renderer_flags = REGL_RENDER_SOFTWARE, bool load_font_in_background = false){
 
     // init sdl
     SDL_Init(SDL_INIT_EVERYTHING);
@@ -114,12 +277,12 @@ void reglInit(bool create_exit_window = true, Uint32 renderer_flags = REGL_RENDE
     makeWindowTransparent(regl_window, RGB(0, 0, 0));
 
     // initialize font
-    loadFont(regl_renderer, "fonts/verdana.ttf");
+    loadFont(regl_renderer, "fonts/verdana.ttf", _default_chars, load_font_in_background);
     
     // create cursors
-    regl_cursors["clickable"] = SDL_CreateSystemCursor(SDL_SYSTEM_CURSOR_HAND);
-    regl_cursors["text"] = SDL_CreateSystemCursor(SDL_SYSTEM_CURSOR_IBEAM);
-    regl_cursors["default"] = SDL_CreateSystemCursor(SDL_SYSTEM_CURSOR_ARROW);
+    regl_cursors[REGL_CURSOR_CLICKABLE] = SDL_CreateSystemCursor(SDL_SYSTEM_CURSOR_HAND);
+    regl_cursors[REGL_CURSOR_TEXT] = SDL_CreateSystemCursor(SDL_SYSTEM_CURSOR_IBEAM);
+    regl_cursors[REGL_CURSOR_DEFAULT] = SDL_CreateSystemCursor(SDL_SYSTEM_CURSOR_ARROW);
 
     // create exit window
     if (create_exit_window){
@@ -152,6 +315,21 @@ void reglQuit(){
     SDL_Quit();
 }
 
+// Get the top enabled object that collides with a rect, NULL if none.
+REGL_Object* objectAt(SDL_Rect other_rect){
+    for (int index = regl_overlays.size() - 1; index != -1; index --){
+        if (regl_overlays[index]->enabled && regl_overlays[index]->collides(other_rect)){
+            return regl_overlays[index];
+        }
+    }
+    for (std::unique_ptr<REGL_Object>& object: ui_objects){
+        if (object->enabled && object->collides(other_rect)){
+            return object.get();
+        }
+    }
+    return NULL;
+}
+
 // Call this in your main loop.
 bool reglUpdate(){
 
@@ -159,19 +337,28 @@ bool reglUpdate(){
     mouse_clicked = false;
     mouse_held = false;
     mouse_up = false;
-    sent_mouse_clicked = false;
-    sent_mouse_held = false;
-    sent_mouse_up = false;
     scrolled = 0;
-    sent_scrolled = false;
-    sent_hovered = false;
+    regl_events.clear();
+
+    // run commands posted from other threads, before cleared child objects they might change are destroyed
+    regl_command_queue.run();
+
+    // destroy child objects cleared last frame, none of them are running now
+    for (REGL_Scene* scene: regl_cleared_scenes){
+        scene->destroyCleared();
+    }
+    regl_cleared_scenes.clear();
+
+    // upload images decoded and glyphs rasterized in the background
+    uploadDecodedImages(regl_renderer);
+    uploadRasterizedGlyphs(regl_renderer);
 
     // clear renderer
     SDL_SetRenderDrawColor(regl_renderer, 0, 0, 0, 0);
     SDL_RenderClear(regl_renderer);
 
-    // reset cursor
-    SDL_SetCursor(regl_cursors["default"]);
+    // reset requested cursor, objects request other cursors when hovered
+    requested_cursor = REGL_CURSOR_DEFAULT;
 
     // get mouse rect
     POINT mouse_pos;
@@ -183,71 +370,100 @@ bool reglUpdate(){
         mouse_held = true;
     }
 
-    // handle events
+    // collect events, mouse events use the same mouse position as hovering and holding
     SDL_Event event;
-    while (SDL_PollEvent(&event) != 0){;
+    while (SDL_PollEvent(&event) != 0){
         if (event.type == SDL_QUIT){
             return false;
         } else if (event.type == SDL_KEYDOWN){
-            // SDL_Keycode key = event.key.keysym.sym;
-        } else if (event.type == SDL_MOUSEBUTTONDOWN){ // mouse clicked?
-            mouse_clicked = true;
-        } else if (event.type == SDL_MOUSEBUTTONUP){ // mouse up?
-            mouse_up = true;
+            REGL_Event key_event = {REGL_EVENT_KEY_DOWN, event.key.timestamp, mouse_rect};
+            key_event.key = event.key.keysym.sym;
+            key_event.modifiers = event.key.keysym.mod;
+            regl_events.push_back(key_event);
+        } else if (event.type == SDL_TEXTINPUT){
+            REGL_Event text_event = {REGL_EVENT_TEXT_INPUT, event.text.timestamp, mouse_rect};
+            text_event.text = event.text.text;
+            regl_events.push_back(text_event);
+        } else if (event.type == SDL_MOUSEBUTTONDOWN || event.type == SDL_MOUSEBUTTONUP){ // mouse clicked or up?
+            REGL_Event mouse_event = {
+                (event.type == SDL_MOUSEBUTTONDOWN) ? REGL_EVENT_CLICKED : REGL_EVENT_MOUSE_UP,
+                event.button.timestamp,
+                mouse_rect
+            };
+            mouse_event.button = event.button.button;
+            mouse_event.clicks = event.button.clicks;
+            regl_events.push_back(mouse_event);
+            mouse_clicked = mouse_clicked || event.type == SDL_MOUSEBUTTONDOWN;
+            mouse_up = mouse_up || event.type == SDL_MOUSEBUTTONUP;
         } else if (event.type == SDL_MOUSEWHEEL){
-            if (event.wheel.y > 0){
-                scrolled = -1;
-            } else if (event.wheel.y < 0){
-                scrolled = 1;
+
+            // wheel up scrolls up
+            int wheel_steps = (event.wheel.direction == SDL_MOUSEWHEEL_FLIPPED) ? event.wheel.y : -event.wheel.y;
+            if (!wheel_steps){
+                continue;
+            }
+            scrolled += wheel_steps;
+
+            // accumulate bursts of wheel events into one event
+            if (!regl_events.empty() && regl_events.back().type == REGL_EVENT_SCROLLED){
+                regl_events.back().scrolled += wheel_steps;
+            } else {
+                REGL_Event scroll_event = {REGL_EVENT_SCROLLED, event.wheel.timestamp, mouse_rect};
+                scroll_event.scrolled = wheel_steps;
+                regl_events.push_back(scroll_event);
             }
+
         }
     }
 
     // rotate positions for making windows on top because we can't rotate while iterating
     top_index = -1;
-    
-    // send events to objects and update and render
-    for (std::unique_ptr<REGL_Object>& object: ui_objects){
 
-        if (object->enabled){
+    // send hover to the top object under the mouse
+    REGL_Object* hovered_object = objectAt(mouse_rect);
+    if (hovered_object){
+        hovered_object->hovered(mouse_rect);
+    }
 
-            // send events if collided with mouse
-            if (object->collides(mouse_rect)){
-
-                // send hover
-                if (!sent_hovered){
-                    object->hovered(mouse_rect);
-                    sent_hovered = true;
-                }
-
-                // send clicked
-                if (mouse_clicked && !sent_mouse_clicked){
-                    object->clicked(mouse_rect);
-                    sent_mouse_clicked = true;
-                }
-
-                // send hold
-                if (mouse_held && !sent_mouse_held){
-                    object->mouseHeld(mouse_rect);
-                    sent_mouse_held = true;
-                }
-
-                // send mouse up
-                if (mouse_up && !sent_mouse_up){
-                    object->mouseUp(mouse_rect);
-                    sent_mouse_up = true;
-                }
-
-                // send scroll
-                if (scrolled != 0 && !sent_scrolled){
-                    object->scrolled(mouse_rect, scrolled);
-                    sent_scrolled = true;
-                }
+    // send events in the order they happened
+    for (REGL_Event& frame_event: regl_events){
 
+        // key and text events go to the focused object
+        if (frame_event.type == REGL_EVENT_KEY_DOWN || frame_event.type == REGL_EVENT_TEXT_INPUT){
+            if (focused_object && focused_object->enabled){
+                focused_object->input(frame_event);
             }
-            
-            object->update();
+            continue;
+        }
 
+        // mouse events go to the top object under the mouse
+        REGL_Object* affected_object = objectAt(frame_event.mouse_rect);
+        if (frame_event.type == REGL_EVENT_CLICKED){
+            focused_object = affected_object;
+        }
+        if (!affected_object){
+            continue;
+        }
+        if (frame_event.type == REGL_EVENT_CLICKED){
+            affected_object->clicked(frame_event.mouse_rect);
+        } else if (frame_event.type == REGL_EVENT_MOUSE_UP){
+            affected_object->mouseUp(frame_event.mouse_rect);
+        } else if (frame_event.type == REGL_EVENT_SCROLLED){
+            affected_object->scrolled(frame_event.mouse_rect, frame_event.scrolled);
+        }
+
+    }
+
+    // send hold
+    REGL_Object* held_object = (mouse_held) ? objectAt(mouse_rect) : NULL;
+    if (held_object){
+        held_object->mouseHeld(mouse_rect);
+    }
+
+    // update objects
+    for (std::unique_ptr<REGL_Object>& object: ui_objects){
+        if (object->enabled){
+            object->update();
         }
     }
 
@@ -256,6 +472,21 @@ bool reglUpdate(){
         moveToBack(ui_objects, top_index);
     }
 
+    // only set cursor if it changed
+    if (requested_cursor != _shown_cursor){
+        SDL_SetCursor(regl_cursors[requested_cursor]);
+        _shown_cursor = requested_cursor;
+    }
+
+    // lay out objects in parallel
+    for (std::unique_ptr<REGL_Object>& object: ui_objects){
+        if (object->enabled){
+            REGL_Object* layout_object = object.get();
+            _layout_tasks.run([layout_object]{layout_object->layout();});
+        }
+    }
+    _layout_tasks.wait();
+
     // render in reverse
     for (int index = ui_objects.size() - 1; index != -1; index --){
         if (ui_objects[index]->enabled){
@@ -263,6 +494,17 @@ bool reglUpdate(){
         }
     }
 
+    // render overlays above everything, then drop closed ones
+    for (size_t index = 0; index < regl_overlays.size(); index ++){
+        if (regl_overlays[index]->enabled){
+            regl_overlays[index]->render(regl_renderer);
+        }
+    }
+    regl_overlays.erase(
+        std::remove_if(regl_overlays.begin(), regl_overlays.end(), [](REGL_Object* overlay){return !overlay->enabled;}),
+        regl_overlays.end()
+    );
+
     // present renderer
     SDL_RenderPresent(regl_renderer);
 
@@ -306,16 +548,13 @@ REGL_Text* addText(
     REGL_Color color,
     int nextline, int indent
 ){
-    auto text_object_ptr = std::make_unique<REGL_Text>(
+    return window->getScene(scene_name).create<REGL_Text>(
         text_content,
         wrapped, wrap_by_words, wrap_margin_left,
         size,
         color,
         nextline, indent
     );
-    auto returned_ptr = text_object_ptr.get();
-    window->scenes[scene_name].push_back(std::move(text_object_ptr));
-    return returned_ptr;
 }
 
 REGL_Button* addButton(
@@ -326,16 +565,13 @@ REGL_Button* addButton(
     int width, int height, int nextline, int indent, int edge_radius,
     REGL_Color color, REGL_Color hovered_color, REGL_Color pressed_color
 ){
-    auto button_object_ptr = std::make_unique<REGL_Button>(
+    return window->getScene(scene_name).create<REGL_Button>(
         text, text_color, text_size,
         outline_color, outline_width,
         on_click,
         width, height, nextline, indent, edge_radius,
         color, hovered_color, pressed_color
     );
-    auto returned_ptr = button_object_ptr.get();
-    window->scenes[scene_name].push_back(std::move(button_object_ptr));
-    return returned_ptr;
 }
 
 REGL_Checkbox* addCheckbox(
@@ -347,7 +583,7 @@ REGL_Checkbox* addCheckbox(
     REGL_Color color, REGL_Color checked_color,
     REGL_Color tick_color
 ){
-    auto checkbox_object_ptr = std::make_unique<REGL_Checkbox>(
+    return window->getScene(scene_name).create<REGL_Checkbox>(
         change_bool,
         on_click,
         width, nextline, indent, edge_radius,
@@ -355,7 +591,249 @@ REGL_Checkbox* addCheckbox(
         color, checked_color,
         tick_color
     );
-    auto returned_ptr = checkbox_object_ptr.get();
-    window->scenes[scene_name].push_back(std::move(checkbox_object_ptr));
-    return returned_ptr;
+}
+REGL_Checkbox* addCheckbox(
+    REGL_Window* window, std::string scene_name,
+    REGL_Observable<bool>& observable_checked,
+    std::function<void()> on_click,
+    int width, int nextline, int indent, int edge_radius,
+    REGL_Color outline_color, float outline_width,
+    REGL_Color color, REGL_Color checked_color,
+    REGL_Color tick_color
+){
+    return window->getScene(scene_name).create<REGL_Checkbox>(
+        observable_checked,
+        on_click,
+        width, nextline, indent, edge_radius,
+        outline_color, outline_width,
+        color, checked_color,
+        tick_color
+    );
+}
+REGL_ListView* addListView(
+    REGL_Window* window, std::string scene_name,
+    std::function<int()> row_count,
+    std::function<std::string(int)> row_at,
+    std::function<int(int)> row_height_at,
+    std::function<void(int)> on_click,
+    int width, int row_height,
+    float text_size, REGL_Color text_color, REGL_Color selected_color,
+    int nextline, int indent
+){
+    return window->getScene(scene_name).create<REGL_ListView>(
+        row_count,
+        row_at,
+        row_height_at,
+        on_click,
+        width, row_height,
+        text_size, text_color, selected_color,
+        nextline, indent
+    );
+}
+
+REGL_Plot* addPlot(
+    REGL_Window* window, std::string scene_name,
+    size_t capacity,
+    int width, int height,
+    REGL_Color line_color, REGL_Color background_color,
+    int nextline, int indent
+){
+    return window->getScene(scene_name).create<REGL_Plot>(
+        capacity,
+        width, height,
+        line_color, background_color,
+        nextline, indent
+    );
+}
+
+REGL_TextInput* addTextInput(
+    REGL_Window* window, std::string scene_name,
+    std::string initial_text, bool multiline,
+    int width, int height,
+    float text_size, REGL_Color text_color, REGL_Color background_color,
+    REGL_Color caret_color, REGL_Color selection_color,
+    std::function<void()> on_change,
+    int nextline, int indent
+){
+    return window->getScene(scene_name).create<REGL_TextInput>(
+        initial_text, multiline,
+        width, height,
+        text_size, text_color, background_color,
+        caret_color, selection_color,
+        on_change,
+        nextline, indent
+    );
+}
+
+REGL_Table* addTable(
+    REGL_Window* window, std::string scene_name,
+    std::vector<std::string> column_names, std::vector<int> column_widths,
+    std::function<int()> row_count,
+    std::function<std::string(int, int)> cell_at,
+    std::function<void(int)> on_click,
+    int width, int row_height,
+    float text_size, REGL_Color text_color, REGL_Color header_color, REGL_Color selected_color,
+    int nextline, int indent
+){
+    return window->getScene(scene_name).create<REGL_Table>(
+        column_names, column_widths,
+        row_count,
+        cell_at,
+        on_click,
+        width, row_height,
+        text_size, text_color, header_color, selected_color,
+        nextline, indent
+    );
+}
+
+REGL_TreeView* addTreeView(
+    REGL_Window* window, std::string scene_name,
+    Uint64 root,
+    std::function<std::vector<Uint64>(Uint64)> children_of,
+    std::function<std::string(Uint64)> node_text,
+    std::function<bool(Uint64)> has_children,
+    std::function<void(Uint64)> on_click,
+    int width, int row_height, int indent_width,
+    float text_size, REGL_Color text_color, REGL_Color selected_color,
+    int nextline, int indent
+){
+    return window->getScene(scene_name).create<REGL_TreeView>(
+        root,
+        children_of,
+        node_text,
+        has_children,
+        on_click,
+        width, row_height, indent_width,
+        text_size, text_color, selected_color,
+        nextline, indent
+    );
+}
+
+REGL_Image* addImage(
+    REGL_Window* window, std::string scene_name,
+    std::string path,
+    int width, int height,
+    int nextline, int indent
+){
+    return window->getScene(scene_name).create<REGL_Image>(
+        path,
+        width, height,
+        nextline, indent
+    );
+}
+
+REGL_Canvas* addCanvas(
+    REGL_Window* window, std::string scene_name,
+    int canvas_width, int canvas_height,
+    int width, int height,
+    int nextline, int indent
+){
+    return window->getScene(scene_name).create<REGL_Canvas>(
+        canvas_width, canvas_height,
+        width, height,
+        nextline, indent
+    );
+}
+
+REGL_LogView* addLogView(
+    REGL_Window* window, std::string scene_name,
+    std::string path,
+    int width, int height,
+    float text_size, REGL_Color text_color, REGL_Color background_color,
+    int nextline, int indent
+){
+    return window->getScene(scene_name).create<REGL_LogView>(
+        path,
+        width, height,
+        text_size, text_color, background_color,
+        nextline, indent
+    );
+}
+
+REGL_ProgressBar* addProgressBar(
+    REGL_Window* window, std::string scene_name,
+    int width, int height, int edge_radius,
+    REGL_Color track_color, REGL_Color fill_color,
+    int nextline, int indent
+){
+    return window->getScene(scene_name).create<REGL_ProgressBar>(
+        width, height, edge_radius,
+        track_color, fill_color,
+        nextline, indent
+    );
+}
+
+REGL_Gauge* addGauge(
+    REGL_Window* window, std::string scene_name,
+    int radius, int thickness,
+    REGL_Color track_color, REGL_Color fill_color,
+    int nextline, int indent
+){
+    return window->getScene(scene_name).create<REGL_Gauge>(
+        radius, thickness,
+        track_color, fill_color,
+        nextline, indent
+    );
+}
+
+REGL_Slider* addSlider(
+    REGL_Window* window, std::string scene_name,
+    float min_value, float max_value, float initial_value, float step,
+    int width, int height,
+    REGL_Color track_color, REGL_Color fill_color, REGL_Color thumb_color,
+    std::function<void(float)> on_change,
+    int nextline, int indent
+){
+    return window->getScene(scene_name).create<REGL_Slider>(
+        min_value, max_value, initial_value, step,
+        width, height,
+        track_color, fill_color, thumb_color,
+        on_change,
+        nextline, indent
+    );
+}
+
+REGL_Dropdown* addDropdown(
+    REGL_Window* window, std::string scene_name,
+    std::vector<std::string> options,
+    std::function<void(int)> on_select,
+    int width, int row_height, int visible_rows,
+    float text_size, REGL_Color text_color, REGL_Color background_color, REGL_Color highlight_color,
+    int nextline, int indent
+){
+    return window->getScene(scene_name).create<REGL_Dropdown>(
+        options,
+        on_select,
+        width, row_height, visible_rows,
+        text_size, text_color, background_color, highlight_color,
+        nextline, indent
+    );
+}
+
+void clearScene(REGL_Window* window, std::string scene_name){
+    window->getScene(scene_name).clear();
+    window->focused_child = NULL;
+}
+
+void reglPost(std::function<void()> function){
+    regl_command_queue.post(NULL, std::move(function));
+}
+
+void reglPost(const void* key, std::function<void()> function){
+    regl_command_queue.post(key, std::move(function));
+}
+
+void postText(REGL_Text* text, std::string new_text){
+    reglPost(&text->text_content, [text, new_text]{text->changeText(new_text);});
+}
+
+void postEnabled(REGL_ChildObject* child_object, bool enabled){
+    reglPost(&child_object->enabled, [child_object, enabled]{
+        child_object->enabled = enabled;
+        child_object->markDirty();
+    });
+}
+
+void postSwitchScene(REGL_Window* window, int scene_id){
+    reglPost(&window->current_scene, [window, scene_id]{window->switchScene(scene_id);});
 }
\ No newline at end of file
@@ -0,0 +1,84 @@
+#include <iostream>
+#include <vector>
+#include <memory>
+
+#include "extern_functions.hpp"
+
+#pragma once
+
+// Bump allocator. Everything allocated from it is freed at once.
+class REGL_Arena{
+
+    public:
+
+        size_t chunk_size; // size of a normal chunk
+        std::vector<std::unique_ptr<char[]>> chunks; // allocated chunks, kept for reuse after reset
+        std::vector<size_t> chunk_sizes; // size of each chunk
+        size_t chunk_index = 0; // chunk currently allocated from
+        size_t used = 0; // bytes used in current chunk
+
+        // allocate memory
+        void* allocate(size_t size, size_t alignment);
+
+        // free everything, chunks are kept so rebuilding doesn't allocate again
+        void reset(){chunk_index = 0; used = 0;};
+
+        // free everything and give chunks back to the system
+        void release(){reset(); chunks.clear(); chunk_sizes.clear();};
+
+        // constructor
+        REGL_Arena(size_t chunk_size = 16384){this->chunk_size = chunk_size;};
+
+};
+
+void* REGL_Arena::allocate(size_t size, size_t alignment){
+
+    while (chunk_index < chunks.size()){
+
+        // align in current chunk
+        size_t start = (reinterpret_cast<uintptr_t>(chunks[chunk_index].get()) + used + alignment - 1) & ~(alignment - 1);
+        start -= reinterpret_cast<uintptr_t>(chunks[chunk_index].get());
+
+        // check if it fits
+        if (start + size <= chunk_sizes[chunk_index]){
+            used = start + size;
+            return chunks[chunk_index].get() + start;
+        }
+
+        // try next chunk
+        chunk_index += 1;
+        used = 0;
+
+    }
+
+    // allocate new chunk, big allocations get a chunk of their own
+    size_t new_chunk_size = regl_max(chunk_size, size + alignment);
+    chunks.push_back(std::unique_ptr<char[]>(new char[new_chunk_size]));
+    chunk_sizes.push_back(new_chunk_size);
+    chunk_index = chunks.size() - 1;
+    used = 0;
+
+    return allocate(size, alignment);
+
+}
+
+// Deleter for objects that might live in an arena. Arena objects are only destructed.
+template <typename SomeClass>
+class REGL_ArenaDeleter{
+
+    public:
+
+        bool in_arena = false; // whether the object lives in an arena
+
+        void operator()(SomeClass* object){
+            if (in_arena){
+                object->~SomeClass();
+            } else {
+                delete object;
+            }
+        };
+
+        // constructor
+        REGL_ArenaDeleter(bool in_arena = false){this->in_arena = in_arena;};
+
+};
\ No newline at end of file
@@ -11,9 +11,35 @@
 #define REGL_RENDER_GPU SDL_RENDERER_ACCELERATED
 #define REGL_RENDER_SOFTWARE SDL_RENDERER_SOFTWARE
 
+// REGL cursors.
+enum REGL_Cursor{
+    REGL_CURSOR_DEFAULT,
+    REGL_CURSOR_CLICKABLE,
+    REGL_CURSOR_TEXT,
+    _REGL_CURSOR_COUNT
+};
+
+// REGL event types.
+enum REGL_EventType{
+    REGL_EVENT_CLICKED,
+    REGL_EVENT_MOUSE_UP,
+    REGL_EVENT_SCROLLED,
+    REGL_EVENT_KEY_DOWN,
+    REGL_EVENT_TEXT_INPUT
+};
+
 // Rect that fills everything (cropping).
 SDL_Rect _FILL_RECT_ALL = {0, 0, 10000, 10000};
 
+// Bytes of images decoded in the background that are uploaded to textures per frame.
+int REGL_TEXTURE_UPLOAD_BUDGET = 4 * 1024 * 1024;
+
+// Bytes of texture memory the texture cache keeps textures that aren't in use in.
+size_t REGL_TEXTURE_CACHE_BUDGET = 256 * 1024 * 1024;
+
+// Number of shaped strings in each generation of the shaping cache of a font, kept per thread.
+size_t REGL_SHAPED_RUN_CACHE_SIZE = 4096;
+
 // Let the child object decide the nextline.
 int REGL_NEXTLINE_DEFAULT = 1294787;
 
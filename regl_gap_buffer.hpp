@@ -0,0 +1,101 @@
+#include <iostream>
+#include <vector>
+#include <string>
+#include <algorithm>
+
+#include "extern_functions.hpp"
+
+#pragma once
+
+// Gap buffer. Text with a gap at the last edit, so typing at the same place doesn't move the rest of the text.
+class REGL_GapBuffer{
+
+    public:
+
+        std::vector<char> buffer; // text before the gap, the gap, and text after the gap
+        size_t gap_start = 0; // position of the gap
+        size_t gap_end = 0; // end of the gap in the buffer
+
+        // get number of characters
+        size_t size(){return buffer.size() - (gap_end - gap_start);};
+
+        // get a character
+        char at(size_t position){return (position < gap_start) ? buffer[position] : buffer[position + gap_end - gap_start];};
+
+        // get part of the text
+        std::string substr(size_t position, size_t count);
+
+        // get all text
+        std::string text(){return substr(0, size());};
+
+        // insert text at a position
+        void insert(size_t position, const std::string& inserted);
+
+        // erase characters from a position
+        void erase(size_t position, size_t count);
+
+        // move the gap to a position
+        void moveGap(size_t position);
+
+        // constructor
+        REGL_GapBuffer(const std::string& initial_text = ""){insert(0, initial_text);};
+
+};
+
+std::string REGL_GapBuffer::substr(size_t position, size_t count){
+
+    position = regl_min(position, size());
+    count = regl_min(count, size() - position);
+    std::string result;
+    result.reserve(count);
+
+    // copy before and after the gap
+    if (position < gap_start){
+        size_t before_count = regl_min(count, gap_start - position);
+        result.append(buffer.data() + position, before_count);
+        position += before_count;
+        count -= before_count;
+    }
+    result.append(buffer.data() + position + gap_end - gap_start, count);
+
+    return result;
+
+}
+
+void REGL_GapBuffer::moveGap(size_t position){
+    if (position < gap_start){
+        std::move_backward(buffer.begin() + position, buffer.begin() + gap_start, buffer.begin() + gap_end);
+        gap_end -= gap_start - position;
+        gap_start = position;
+    } else if (position > gap_start){
+        size_t moved = position - gap_start;
+        std::move(buffer.begin() + gap_end, buffer.begin() + gap_end + moved, buffer.begin() + gap_start);
+        gap_start += moved;
+        gap_end += moved;
+    }
+}
+
+void REGL_GapBuffer::insert(size_t position, const std::string& inserted){
+
+    moveGap(regl_min(position, size()));
+
+    // grow gap if it is too small, the gap grows with the text so inserting stays cheap
+    if (gap_end - gap_start < inserted.size()){
+        size_t after_count = buffer.size() - gap_end;
+        size_t new_gap = inserted.size() + regl_max(size_t(64), buffer.size() / 2);
+        buffer.resize(gap_start + new_gap + after_count);
+        std::move_backward(buffer.begin() + gap_end, buffer.begin() + gap_end + after_count, buffer.end());
+        gap_end = gap_start + new_gap;
+    }
+
+    std::copy(inserted.begin(), inserted.end(), buffer.begin() + gap_start);
+    gap_start += inserted.size();
+
+}
+
+void REGL_GapBuffer::erase(size_t position, size_t count){
+    position = regl_min(position, size());
+    count = regl_min(count, size() - position);
+    moveGap(position);
+    gap_end += count;
+}
\ No newline at end of file
@@ -3,8 +3,17 @@
 #include <unordered_map>
 #include <functional>
 #include <algorithm>
+#include <deque>
+#include <mutex>
+#include <atomic>
+#include <cstring>
+#include <cmath>
 
 #include "extern_functions.hpp"
+#include "regl_arena.hpp"
+#include "regl_observable.hpp"
+#include "regl_gap_buffer.hpp"
+#include "regl_option_index.hpp"
 #include "sdl_functions.hpp"
 #include "font_renderer.hpp"
 #include "color.hpp"
@@ -18,17 +27,53 @@
 // Class forward declarations.
 class REGL_Object;
 class REGL_ChildObject;
+class REGL_Scene;
 class REGL_Window;
 class REGL_Text;
 class REGL_Button;
+class REGL_ListView;
+class REGL_Plot;
+class REGL_TextInput;
+class REGL_Table;
+class REGL_TreeView;
+class REGL_Image;
+class REGL_Canvas;
+class REGL_LogView;
+class REGL_ProgressBar;
+class REGL_Gauge;
+class REGL_Slider;
+class REGL_Dropdown;
 
 // Variables that REGL_Objects might need.
 extern bool mouse_held;
 extern bool mouse_clicked;
 extern int top_index;
 extern SDL_Rect mouse_rect;
-extern std::unordered_map<std::string, SDL_Cursor*> regl_cursors;
+extern REGL_Cursor requested_cursor;
 extern std::vector<std::unique_ptr<REGL_Object>> ui_objects;
+extern std::vector<REGL_Object*> regl_overlays;
+extern std::vector<REGL_Scene*> regl_cleared_scenes;
+extern REGL_Object* focused_object;
+
+// Event collected from SDL events, in the order they happened.
+class REGL_Event{
+
+    public:
+
+        REGL_EventType type; // event type
+        Uint32 timestamp; // SDL ticks when the event happened
+        SDL_Rect mouse_rect; // mouse position when the event happened
+        int button = 0; // mouse button of clicks
+        int clicks = 0; // number of clicks in a row, 2 for double clicks
+        int scrolled = 0; // accumulated wheel steps, positive when scrolling down
+        SDL_Keycode key = 0; // pressed key
+        Uint16 modifiers = 0; // held modifier keys
+        std::string text; // typed text
+
+};
+
+// Events of the current frame.
+extern std::vector<REGL_Event> regl_events;
 
 // Base class for all rendered objects.
 class REGL_Object{
@@ -56,6 +101,9 @@ class REGL_Object{
         // update function
         virtual void update();
 
+        // layout function, runs on a worker thread before rendering
+        virtual void layout(){};
+
         // click function
         virtual void clicked(SDL_Rect mouse_rect){};
 
@@ -71,8 +119,8 @@ class REGL_Object{
         // scrolled function
         virtual void scrolled(SDL_Rect mouse_rect, int scrolled){};
 
-        // input function
-        void input(SDL_Keycode key);
+        // input function, gets key and text events while focused
+        virtual void input(const REGL_Event& event){};
 
         // collide function
         virtual bool collides(SDL_Rect other_rect);
@@ -130,6 +178,10 @@ class REGL_ChildObject{
         int indent; // indentation in pixels
         bool enabled = true; // ignore this if it is disabled
         int decided_nextline; // use this if the nextline was selected as default
+        bool dirty = true; // changed since the last layout, set when a bound value changes
+        std::vector<std::function<void()>> unbinds; // unsubscribe from bound values
+        REGL_Scene* scene = NULL; // scene this child object is in
+        int scene_index = -1; // index in the scene's objects
 
         // different render function from regl objects
         virtual void render(SDL_Renderer* renderer, int x, int y, REGL_Window* window){};
@@ -145,6 +197,8 @@ class REGL_ChildObject{
 
         // scrolled function
         virtual void scrolled(SDL_Rect mouse_rect, int scrolled){};
+        // whether scrolled would scroll the object, the window doesn't scroll then
+        virtual bool consumesScroll(SDL_Rect mouse_rect, int scrolled){return false;};
 
         // hovered function
         virtual void hovered(SDL_Rect mouse_rect){};
@@ -152,14 +206,28 @@ class REGL_ChildObject{
         // collide function
         virtual bool collides(SDL_Rect other_rect, int x, int y){return false;};
 
+        // layout function, measure the child object here instead of in render
+        // this runs on a worker thread, so only change this child object and don't call user functions
+        virtual void layout(REGL_Window* window){};
+
+        // get bounds relative to the render position, used for culling and hit testing
+        virtual SDL_Rect bounds(){return {0, 0, 0, getNextline()};};
+
         // get nextline
         int getNextline(){return (nextline == REGL_NEXTLINE_DEFAULT) ? decided_nextline : nextline;};
 
-        // input function
-        void input(SDL_Keycode key);
+        // input function, gets key and text events while focused
+        virtual void input(const REGL_Event& event){};
+
+        // mark as changed, so the scene measures it again and takes its enabled, nextline and indent
+        void markDirty();
+
+        // call a function now and whenever an observable value changes, the value must outlive this
+        template <typename T>
+        void bind(REGL_Observable<T>& observable, std::function<void(const T&)> on_change);
 
         // destructor
-        ~REGL_ChildObject(){};
+        virtual ~REGL_ChildObject(){for (std::function<void()>& unbind: unbinds){unbind();}};
 
         // constructor
         REGL_ChildObject(int nextline, int indent){this->nextline = nextline; this->indent = indent;};
@@ -167,6 +235,214 @@ class REGL_ChildObject{
 
 };
 
+template <typename T>
+void REGL_ChildObject::bind(REGL_Observable<T>& observable, std::function<void(const T&)> on_change){
+
+    // take current value
+    on_change(observable.get());
+    markDirty();
+
+    // take changed values
+    int id = observable.subscribe([this, on_change](const T& value){
+        on_change(value);
+        markDirty();
+    });
+    unbinds.push_back([&observable, id]{observable.unsubscribe(id);});
+
+}
+
+// Scene class. Owns child objects and keeps their layout in contiguous arrays.
+// The arrays are only updated from child objects that were marked dirty, so layout doesn't touch the others.
+class REGL_Scene{
+
+    public:
+
+        REGL_Arena arena; // memory of child objects created in this scene
+        REGL_Arena cleared_arena; // memory of cleared child objects, swapped back in by the next clear once they are destroyed
+        std::vector<std::unique_ptr<REGL_ChildObject, REGL_ArenaDeleter<REGL_ChildObject>>> objects; // child objects
+        std::vector<std::unique_ptr<REGL_ChildObject, REGL_ArenaDeleter<REGL_ChildObject>>> cleared_objects; // cleared child objects, destroyed at the start of the next frame
+
+        // layout of each child object, by index in objects
+        std::vector<char> enabled_flags; // whether the child object is enabled
+        std::vector<int> indents; // x offsets from the window
+        std::vector<int> nextlines; // heights taken in the window
+        std::vector<SDL_Rect> child_bounds; // bounds relative to the child object's position
+        std::vector<int> dirty_indices; // child objects to measure again
+
+        // packed layout of enabled child objects, rebuilt by layout
+        std::vector<int> object_indices; // index of child object in objects
+        std::vector<int> offsets; // y offsets from the top of the content
+        int total_height = 0; // total height of enabled child objects
+        bool changed = true; // whether a child object was marked dirty since the last layout
+
+        // add a child object allocated somewhere else
+        void push_back(std::unique_ptr<REGL_ChildObject> object);
+
+        // start tracking the layout of the last added child object
+        void track(REGL_ChildObject* object);
+
+        // create a child object in this scene's arena
+        template <typename SomeClass, typename... Args>
+        SomeClass* create(Args&&... args);
+
+        // remove all child objects, they are destroyed at the start of the next frame as one of them might be calling this
+        void clear();
+
+        // destroy cleared child objects, their memory is reused by child objects created after the next clear
+        void destroyCleared();
+
+        // measure child objects and pack their layout
+        void layout(REGL_Window* window);
+
+        // get index in the packed layout of a child object that collides with a rect, -1 if none
+        int collidedIndex(SDL_Rect other_rect, int content_x, int content_y);
+
+        // destructor
+        ~REGL_Scene();
+
+};
+
+template <typename SomeClass, typename... Args>
+SomeClass* REGL_Scene::create(Args&&... args){
+    SomeClass* object = new (arena.allocate(sizeof(SomeClass), alignof(SomeClass))) SomeClass(std::forward<Args>(args)...);
+    objects.emplace_back(object, REGL_ArenaDeleter<REGL_ChildObject>(true));
+    track(object);
+    return object;
+}
+
+void REGL_Scene::push_back(std::unique_ptr<REGL_ChildObject> object){
+    objects.emplace_back(object.release());
+    track(objects.back().get());
+}
+
+void REGL_Scene::track(REGL_ChildObject* object){
+
+    object->scene = this;
+    object->scene_index = objects.size() - 1;
+
+    // measured in the next layout
+    enabled_flags.push_back(false);
+    indents.push_back(0);
+    nextlines.push_back(0);
+    child_bounds.push_back({0, 0, 0, 0});
+    dirty_indices.push_back(object->scene_index);
+    object->dirty = true;
+    changed = true;
+
+}
+
+void REGL_ChildObject::markDirty(){
+    if (scene && !dirty){
+        scene->dirty_indices.push_back(scene_index);
+        scene->changed = true;
+    }
+    dirty = true;
+}
+
+void REGL_Scene::clear(){
+
+    // keep child objects until the next frame, new child objects use the other arena
+    if (cleared_objects.empty()){
+        regl_cleared_scenes.push_back(this);
+        std::swap(arena, cleared_arena);
+    }
+    for (auto& object: objects){
+        object->scene = NULL;
+        cleared_objects.push_back(std::move(object));
+    }
+    objects.clear();
+
+    // clear layout
+    enabled_flags.clear();
+    indents.clear();
+    nextlines.clear();
+    child_bounds.clear();
+    dirty_indices.clear();
+    object_indices.clear();
+    offsets.clear();
+    total_height = 0;
+    changed = true;
+
+}
+
+void REGL_Scene::destroyCleared(){
+    cleared_objects.clear();
+    cleared_arena.reset();
+}
+
+REGL_Scene::~REGL_Scene(){
+    regl_cleared_scenes.erase(std::remove(regl_cleared_scenes.begin(), regl_cleared_scenes.end(), this), regl_cleared_scenes.end());
+}
+
+void REGL_Scene::layout(REGL_Window* window){
+
+    // mark child objects whose enabled, indent or nextline were assigned directly
+    for (size_t index = 0; index < objects.size(); index ++){
+        REGL_ChildObject* child_object = objects[index].get();
+        if (
+            child_object->enabled != bool(enabled_flags[index])
+            || (child_object->enabled && (child_object->indent != indents[index] || child_object->getNextline() != nextlines[index]))
+        ){
+            child_object->markDirty();
+        }
+    }
+
+    // nothing to do if no child object changed
+    if (!changed){
+        return;
+    }
+    changed = false;
+
+    // measure child objects that changed
+    for (int index: dirty_indices){
+        REGL_ChildObject* child_object = objects[index].get();
+        child_object->dirty = false;
+        enabled_flags[index] = child_object->enabled;
+        if (!child_object->enabled){
+            continue;
+        }
+        child_object->layout(window);
+        indents[index] = child_object->indent;
+        nextlines[index] = child_object->getNextline();
+        child_bounds[index] = child_object->bounds();
+    }
+    dirty_indices.clear();
+
+    // pack enabled child objects, disabled ones don't take up space
+    object_indices.clear();
+    offsets.clear();
+    total_height = 0;
+    for (size_t index = 0; index < enabled_flags.size(); index ++){
+        if (enabled_flags[index]){
+            object_indices.push_back(index);
+            offsets.push_back(total_height);
+            total_height += nextlines[index];
+        }
+    }
+
+}
+
+int REGL_Scene::collidedIndex(SDL_Rect other_rect, int content_x, int content_y){
+    for (size_t index = 0; index < object_indices.size(); index ++){
+
+        // check packed bounds first
+        int object_index = object_indices[index];
+        SDL_Rect bounds_rect = child_bounds[object_index];
+        bounds_rect.x += content_x + indents[object_index];
+        bounds_rect.y += content_y + offsets[index];
+        if (!SDL_HasIntersection(&bounds_rect, &other_rect)){
+            continue;
+        }
+
+        // let the child object decide
+        if (objects[object_index]->collides(other_rect, content_x + indents[object_index], content_y + offsets[index])){
+            return index;
+        }
+
+    }
+    return -1;
+}
+
 // Window class.
 class REGL_Window : public REGL_Object{
 
@@ -195,8 +471,10 @@ class REGL_Window : public REGL_Object{
         int before_held_viewport_y; // viewport y before being held
         int before_held_viewport_difference; // viewport difference before being held
         int child_objects_height; // total child object height, calculated in render function
-        std::unordered_map<std::string, std::vector<std::unique_ptr<REGL_ChildObject>>> scenes; // scenes
-        std::string current_scene = REGL_SCENE_DEFAULT; // current scene
+        std::deque<REGL_Scene> scenes; // scenes, indexed by scene id
+        std::unordered_map<std::string, int> scene_ids; // scene ids by name
+        int current_scene; // current scene id
+        REGL_ChildObject* focused_child = NULL; // last clicked child object, gets key and text events
         bool ON_TOP_WHEN_CLICKED = true;
 
         // custom render function
@@ -217,12 +495,28 @@ class REGL_Window : public REGL_Object{
         // custom hovered function
         void hovered(SDL_Rect mouse_rect) override;
 
+        // custom input function
+        void input(const REGL_Event& event) override;
+
         // custom collides function
         bool collides(SDL_Rect other_rect) override;
 
         // custom update function
         void update() override;
 
+        // measure child objects of the current scene
+        void layout() override;
+
+        // get id of a scene, the scene is created if it doesn't exist
+        int sceneId(std::string scene_name);
+
+        // get a scene by name, the scene is created if it doesn't exist
+        REGL_Scene& getScene(std::string scene_name){return scenes[sceneId(scene_name)];};
+
+        // switch current scene, scenes that don't exist are ignored
+        void switchScene(int scene_id);
+        void switchScene(std::string scene_name);
+
         // return a child obejct that collides with another rect
         bool collidedChild(SDL_Rect other_rect, REGL_ChildObject* &result_child);
 
@@ -259,21 +553,59 @@ REGL_Window::REGL_Window(
     this->bar_text_size = bar_text_size;
     this->scrollbar_width = scrollbar_width;
     this->scrollbar_color = scrollbar_color;
+    this->current_scene = sceneId(REGL_SCENE_DEFAULT);
 
 }
 
-bool REGL_Window::collidedChild(SDL_Rect other_rect, REGL_ChildObject* &result_child){
-    int render_y = y + viewport_y + 10;
-    for (std::unique_ptr<REGL_ChildObject>& child_object: scenes[current_scene]){
-        if (child_object->collides(other_rect, x + child_object->indent, render_y)){
-            result_child = child_object.get();
-            return true;
-        }
+int REGL_Window::sceneId(std::string scene_name){
 
-        // increment render y
-        render_y += child_object->getNextline();
+    // check if scene exists
+    auto found = scene_ids.find(scene_name);
+    if (found != scene_ids.end()){
+        return found->second;
     }
-    return false;
+
+    // create scene
+    scenes.emplace_back();
+    scene_ids[scene_name] = scenes.size() - 1;
+    return scenes.size() - 1;
+
+}
+
+void REGL_Window::switchScene(int scene_id){
+    if (scene_id < 0 || scene_id >= int(scenes.size())){
+        return;
+    }
+    current_scene = scene_id;
+    focused_child = NULL;
+}
+
+void REGL_Window::switchScene(std::string scene_name){
+    auto found = scene_ids.find(scene_name);
+    if (found != scene_ids.end()){
+        switchScene(found->second);
+    }
+}
+
+bool REGL_Window::collidedChild(SDL_Rect other_rect, REGL_ChildObject* &result_child){
+    REGL_Scene& scene = scenes[current_scene];
+    int index = scene.collidedIndex(other_rect, x, y + viewport_y + 10);
+    if (index == -1){
+        return false;
+    }
+    result_child = scene.objects[scene.object_indices[index]].get();
+    return true;
+}
+
+void REGL_Window::layout(){
+
+    // measure and pack child objects
+    REGL_Scene& scene = scenes[current_scene];
+    scene.layout(this);
+
+    // get total height of child objects
+    child_objects_height = scene.total_height;
+
 }
 
 void REGL_Window::moveOnTop(){
@@ -366,9 +698,11 @@ void REGL_Window::clicked(SDL_Rect mouse_rect){
         return;
     }
 
-    // send click to children
+    // send click to children, clicked child gets focus
     REGL_ChildObject* affected_child;
+    focused_child = NULL;
     if (collidedChild(mouse_rect, affected_child)){
+        focused_child = affected_child;
         affected_child->clicked(mouse_rect);
     }
 
@@ -401,25 +735,30 @@ void REGL_Window::mouseUp(SDL_Rect mouse_rect){
 
 void REGL_Window::scrolled(SDL_Rect mouse_rect, int scrolled){
 
-    // window scrolling
-    if (scrolled == -1){
+    // send scroll to children, the window only scrolls if they don't
+    REGL_ChildObject* affected_child;
+    if (collidedChild(mouse_rect, affected_child)){
+        bool consumed = affected_child->consumesScroll(mouse_rect, scrolled);
+        affected_child->scrolled(mouse_rect, scrolled);
+        if (consumed){
+            return;
+        }
+    }
+
+    // window scrolling, scroll further for faster wheel movement
+    int scroll_distance = SCROLL_SCALE * std::abs(scrolled);
+    if (scrolled < 0){
 
-        viewport_y += regl_min(SCROLL_SCALE, std::abs(bar_height - viewport_y));
+        viewport_y += regl_min(scroll_distance, std::abs(bar_height - viewport_y));
 
-    } else if (scrolled == 1){
+    } else if (scrolled > 0){
 
         // change viewport y
         if (child_objects_height > height){
-            viewport_y -= regl_min(SCROLL_SCALE, std::abs(child_objects_height - height + viewport_y));
+            viewport_y -= regl_min(scroll_distance, std::abs(child_objects_height - height + viewport_y));
         }
     }
 
-    // send scroll to children
-    REGL_ChildObject* affected_child;
-    if (collidedChild(mouse_rect, affected_child)){
-        affected_child->scrolled(mouse_rect, scrolled);
-    }
-
 }
 
 void REGL_Window::hovered(SDL_Rect mouse_rect){
@@ -430,6 +769,13 @@ void REGL_Window::hovered(SDL_Rect mouse_rect){
     }
 }
 
+void REGL_Window::input(const REGL_Event& event){
+    // send input to focused child
+    if (focused_child && focused_child->enabled){
+        focused_child->input(event);
+    }
+}
+
 void REGL_Window::render(SDL_Renderer* renderer){
 
     // update rects
@@ -448,26 +794,26 @@ void REGL_Window::render(SDL_Renderer* renderer){
 
     }
 
-    int render_y = y + viewport_y + 10;
-    child_objects_height = 0; // reset child objects height and recalculate
-    for (std::unique_ptr<REGL_ChildObject>& child_object: scenes[current_scene]){
-        
-        // ignore if disabled
-        if (child_object->enabled){
-
-            // check if minimized
-            if (!minimized){
-
-                // render and increase render y
-                child_object->render(renderer, x + child_object->indent, render_y, this);
+    // render child objects if not minimized, they were measured in layout
+    if (!minimized){
 
+        REGL_Scene& scene = scenes[current_scene];
+        int content_y = y + viewport_y + 10;
+        for (size_t index = 0; index < scene.object_indices.size(); index ++){
+
+            // cull child objects outside the window
+            int object_index = scene.object_indices[index];
+            SDL_Rect bounds_rect = scene.child_bounds[object_index];
+            bounds_rect.x += x + scene.indents[object_index];
+            bounds_rect.y += content_y + scene.offsets[index];
+            if (!SDL_HasIntersection(&bounds_rect, &rect)){
+                continue;
             }
 
-            // increase render y
-            render_y += child_object->getNextline();
-
-            // get total height of child objects
-            child_objects_height += child_object->getNextline();
+            // render
+            scene.objects[object_index]->render(
+                renderer, x + scene.indents[object_index], content_y + scene.offsets[index], this
+            );
 
         }
 
@@ -538,17 +884,34 @@ class REGL_Text : public REGL_ChildObject{
         bool wrapped; // whether to wrap text
         bool wrap_by_words; // whether to wrap by words
         int wrap_margin_left; // margin to wrap by
+        REGL_Font* font = NULL; // font, default font if NULL
         int end_indents = 0; // number of newlines at the end of the text
+        std::vector<std::string> lines; // wrapped lines, calculated in layout function
+        std::string laid_out_text; // text content when lines were calculated
+        int laid_out_width = -1; // wrap width when lines were calculated
+        float laid_out_size = 0; // size when lines were calculated
+        REGL_Font* laid_out_font = NULL; // font when lines were calculated
+        int line_height = 0; // height of a line
+        int bounds_width = 0; // width of the widest line
 
         // custom render function
         void render(SDL_Renderer* renderer, int x, int y, REGL_Window* window) override;
 
+        // custom layout function
+        void layout(REGL_Window* window) override;
+
+        // custom bounds function
+        SDL_Rect bounds() override;
+
         // custom collides functin
         bool collides(SDL_Rect other_rect){return true;};
 
         // change text
         void changeText(std::string new_text);
 
+        // show the value of an observable string
+        void bindText(REGL_Observable<std::string>& observable);
+
         // constructor
         REGL_Text(
             std::string text_content,
@@ -581,7 +944,7 @@ REGL_Text::REGL_Text(
     }
 
     // check if text content ends with newline, is illegal
-    while (this->text_content.substr(this->text_content.size() - 1, this->text_content.size()) == "\n"){
+    while (this->text_content.size() && this->text_content.back() == '\n'){
         this->text_content = this->text_content.substr(0, this->text_content.size() - 1);
         this->end_indents += 1;
     }
@@ -594,21 +957,38 @@ void REGL_Text::changeText(std::string new_text){
     end_indents = 0;
 
     // check if text content ends with newline, is illegal
-    while (new_text.substr(new_text.size() - 1, new_text.size()) == "\n"){
+    while (new_text.size() && new_text.back() == '\n'){
         new_text = new_text.substr(0, new_text.size() - 1);
         end_indents += 1;
     }
 
     // set textcontent
     text_content = new_text;
+    markDirty();
 
 }
 
-void REGL_Text::render(SDL_Renderer* renderer, int x, int y, REGL_Window* window){
+void REGL_Text::bindText(REGL_Observable<std::string>& observable){
+    bind<std::string>(observable, [this](const std::string& new_text){changeText(new_text);});
+}
 
-    // simply render if no wrap
+void REGL_Text::layout(REGL_Window* window){
+
+    // only wrap again if something changed
+    int wrap_width = (wrapped) ? window->width - wrap_margin_left : window->width;
+    if (laid_out_width == wrap_width && laid_out_size == size && laid_out_font == font && laid_out_text == text_content){
+        return;
+    }
+    laid_out_text = text_content;
+    laid_out_width = wrap_width;
+    laid_out_size = size;
+    laid_out_font = font;
+    line_height = textHeight(text_content, size, font);
+
+    // simply use one line if no wrap
     if (!wrapped){
-        renderText(renderer, color, text_content, x, y, size, window->width, window->rect);
+        lines = {text_content};
+        bounds_width = textWidth(text_content, size, wrap_width, font);
         return;
     }
 
@@ -619,7 +999,7 @@ void REGL_Text::render(SDL_Renderer* renderer, int x, int y, REGL_Window* window
     while (true){
 
         // get wrap index
-        int wrap_index = textWrapIndex(text_content.substr(new_slice_index, -1), size, window->width - wrap_margin_left, wrap_by_words);
+        int wrap_index = textWrapIndex(text_content.substr(new_slice_index, -1), size, window->width - wrap_margin_left, wrap_by_words, font);
 
         // exit if no more wrap
         if (wrap_index == -1){
@@ -637,15 +1017,30 @@ void REGL_Text::render(SDL_Renderer* renderer, int x, int y, REGL_Window* window
     // add last substring
     texts_to_render.push_back(text_content.substr(new_slice_index, text_content.size()));
 
-    // render texts
-    int text_y = y;
-    for (std::string rendered_text: texts_to_render){
-        renderText(renderer, color, rendered_text, x, text_y, size, window->width, window->rect);
-        text_y += textHeight(text_content, size);
+    // store lines
+    lines = std::move(texts_to_render);
+    bounds_width = 0;
+    for (std::string& line: lines){
+        bounds_width = regl_max(bounds_width, int(textWidth(line, size, wrap_width, font)));
     }
 
     // set decided nextline
-    decided_nextline = text_y - y + 10 + (textHeight(text_content, size) * end_indents);
+    decided_nextline = lines.size() * line_height + 10 + (line_height * end_indents);
+
+}
+
+SDL_Rect REGL_Text::bounds(){
+    return {0, 0, bounds_width, int(lines.size()) * line_height + 2};
+}
+
+void REGL_Text::render(SDL_Renderer* renderer, int x, int y, REGL_Window* window){
+
+    // render lines
+    int text_y = y;
+    for (std::string& rendered_text: lines){
+        renderText(renderer, color, rendered_text, x, text_y, size, window->width, window->rect, font);
+        text_y += line_height;
+    }
 
 }
 
@@ -668,6 +1063,7 @@ class REGL_Button : public REGL_ChildObject{
         REGL_Color pressed_color; // color when pressed
         REGL_Color color; // normal color
         REGL_Color current_color; // current render color
+        REGL_Font* font = NULL; // text font, default font if NULL
 
         // custom render function
         void render(SDL_Renderer* renderer, int x, int y, REGL_Window* window) override;
@@ -684,6 +1080,9 @@ class REGL_Button : public REGL_ChildObject{
         // custom collides function
         bool collides(SDL_Rect other_rect, int x, int y) override;
 
+        // custom bounds function
+        SDL_Rect bounds() override;
+
         // constructor
         REGL_Button(
             std::string text,
@@ -749,10 +1148,11 @@ void REGL_Button::render(SDL_Renderer* renderer, int x, int y, REGL_Window* wind
     renderText(
         renderer,
         text_color, text,
-        (x + current_width / 2) - textWidth(text, text_size) / 2, (y + current_height / 2) - textHeight(text, text_size) / 2,
+        (x + current_width / 2) - textWidth(text, text_size, 10000, font) / 2, (y + current_height / 2) - textHeight(text, text_size, font) / 2,
         text_size,
         10000,
-        draw_rect
+        draw_rect,
+        font
     );
 
     // set current render color
@@ -774,7 +1174,7 @@ void REGL_Button::hovered(SDL_Rect mouse_rect){
     current_color = hovered_color;
 
     // change cursor
-    SDL_SetCursor(regl_cursors["clickable"]);
+    requested_cursor = REGL_CURSOR_CLICKABLE;
 
 }
 
@@ -802,6 +1202,13 @@ bool REGL_Button::collides(SDL_Rect other_rect, int x, int y){
     return SDL_HasIntersection(&collision_rect, &other_rect);
 }
 
+SDL_Rect REGL_Button::bounds(){
+    return {
+        int(-outline_width / 2), int(-outline_width / 2),
+        int(width + outline_width) + 1, int(height + outline_width) + 1
+    };
+}
+
 class REGL_Checkbox : public REGL_ChildObject{
 
     public:
@@ -811,13 +1218,14 @@ class REGL_Checkbox : public REGL_ChildObject{
         int width, height; // dimensions
         REGL_Color outline_color; // outline color
         float outline_width; // outline width
-        bool& change_bool; // bool to set when clicked
+        bool* change_bool = NULL; // bool to set when clicked
+        REGL_Observable<bool>* observable_checked = NULL; // observable to set when clicked
         std::function<void()> on_click; // function called when clicked
         REGL_Color pressed_color; // color when pressed
         REGL_Color color; // normal color
         REGL_Color checked_color; // current render color
         REGL_Color tick_color; // tick color
-        SDL_Texture* tick_texture; // tick texture
+        REGL_MipTexture tick_texture = REGL_MipTexture("images/checkbox-tick.png"); // mip levels of the tick texture
 
         // custom render function
         void render(SDL_Renderer* renderer, int x, int y, REGL_Window* window) override;
@@ -831,6 +1239,12 @@ class REGL_Checkbox : public REGL_ChildObject{
         // custom collides function
         bool collides(SDL_Rect other_rect, int x, int y) override;
 
+        // custom bounds function
+        SDL_Rect bounds() override;
+
+        // follow an observable bool and set it when clicked
+        void bindChecked(REGL_Observable<bool>& observable);
+
         // constructor
         REGL_Checkbox(
             bool& change_bool,
@@ -840,6 +1254,25 @@ class REGL_Checkbox : public REGL_ChildObject{
             REGL_Color color, REGL_Color checked_color,
             REGL_Color tick_color
         );
+        REGL_Checkbox(
+            REGL_Observable<bool>& observable_checked,
+            std::function<void()> on_click,
+            int width, int nextline, int indent, int edge_radius,
+            REGL_Color outline_color, float outline_width,
+            REGL_Color color, REGL_Color checked_color,
+            REGL_Color tick_color
+        );
+
+    private:
+
+        // set up everything the constructors share
+        void init(
+            std::function<void()> on_click,
+            int width, int edge_radius,
+            REGL_Color outline_color, float outline_width,
+            REGL_Color color, REGL_Color checked_color,
+            REGL_Color tick_color
+        );
 
 };
 
@@ -850,7 +1283,36 @@ REGL_Checkbox::REGL_Checkbox(
     REGL_Color outline_color, float outline_width,
     REGL_Color color, REGL_Color checked_color,
     REGL_Color tick_color
-) : REGL_ChildObject(nextline, indent), change_bool(change_bool){
+) : REGL_ChildObject(nextline, indent){
+
+    this->change_bool = &change_bool;
+    init(on_click, width, edge_radius, outline_color, outline_width, color, checked_color, tick_color);
+
+}
+
+REGL_Checkbox::REGL_Checkbox(
+    REGL_Observable<bool>& observable_checked,
+    std::function<void()> on_click,
+    int width, int nextline, int indent, int edge_radius,
+    REGL_Color outline_color, float outline_width,
+    REGL_Color color, REGL_Color checked_color,
+    REGL_Color tick_color
+) : REGL_ChildObject(nextline, indent){
+
+    init(on_click, width, edge_radius, outline_color, outline_width, color, checked_color, tick_color);
+
+    // take checked from the observable
+    bindChecked(observable_checked);
+
+}
+
+void REGL_Checkbox::init(
+    std::function<void()> on_click,
+    int width, int edge_radius,
+    REGL_Color outline_color, float outline_width,
+    REGL_Color color, REGL_Color checked_color,
+    REGL_Color tick_color
+){
 
     this->on_click = on_click;
     this->width = width;
@@ -868,12 +1330,15 @@ REGL_Checkbox::REGL_Checkbox(
 
 }
 
+void REGL_Checkbox::bindChecked(REGL_Observable<bool>& observable){
+    observable_checked = &observable;
+    bind<bool>(observable, [this](const bool& value){checked = value;});
+}
+
 void REGL_Checkbox::render(SDL_Renderer* renderer, int x, int y, REGL_Window* window){
 
-    // load texture if not loaded
-    if (!tick_texture){
-        tick_texture = loadTexture(renderer, "images/checkbox-tick.png");
-    }
+    // load texture and its mip levels in the background, so the tick is ready when checked
+    tick_texture.load(renderer);
 
     // draw outline
     SDL_Rect outline_draw_rect = {
@@ -888,33 +1353,10 @@ void REGL_Checkbox::render(SDL_Renderer* renderer, int x, int y, REGL_Window* wi
     // draw rounded rect
     drawRoundedRect(renderer, to_draw_rect, edge_radius, checked ? checked_color : color, window->rect);
 
-    // draw tick if checked
+    // draw tick if checked, using the mip level closest to the tick size
     if (checked){
-
-        // get tick rect
         SDL_Rect tick_rect = {x, int(y + height * 0.1f), int(width * 0.9f * 1.15f), int(height * 0.9)};
-
-        // crop tick rect
-        SDL_Rect cropped_rect = getIncludeCrop(tick_rect, window->rect);
-
-        // get new render rect
-        SDL_Rect render_rect = {
-            tick_rect.x + cropped_rect.x,
-            tick_rect.y + cropped_rect.y,
-            cropped_rect.w,
-            cropped_rect.h,
-        };
-
-        // fix crop rect
-        cropped_rect.x = 425 * cropped_rect.x / (width * 0.9f * 1.15f);
-        cropped_rect.y = 368 * cropped_rect.y / (height * 0.9);
-        cropped_rect.w = 425 * cropped_rect.w / (width * 0.9f * 1.15f);
-        cropped_rect.h = 368 * cropped_rect.h / (height * 0.9);
-
-        // render tick
-        SDL_SetTextureColorMod(tick_texture, tick_color.r, tick_color.g, tick_color.b);
-        SDL_RenderCopy(renderer, tick_texture, &cropped_rect, &render_rect);
-
+        tick_texture.render(renderer, tick_rect, window->rect, tick_color);
     }
 
 }
@@ -925,7 +1367,12 @@ void REGL_Checkbox::clicked(SDL_Rect mouse_rect){
     checked = (!checked);
 
     // set bool
-    change_bool = checked;
+    if (change_bool){
+        *change_bool = checked;
+    }
+    if (observable_checked){
+        observable_checked->set(checked);
+    }
 
     // execute function
     on_click();
@@ -937,6 +1384,3045 @@ bool REGL_Checkbox::collides(SDL_Rect other_rect, int x, int y){
     return SDL_HasIntersection(&collision_rect, &other_rect);
 }
 
+SDL_Rect REGL_Checkbox::bounds(){
+    return {
+        int(-outline_width / 2), int(-outline_width / 2),
+        int(width + outline_width) + 1, int(height + outline_width) + 1
+    };
+}
+
 void REGL_Checkbox::hovered(SDL_Rect mouse_rect){
-    SDL_SetCursor(regl_cursors["clickable"]); // set cursor to clickable
+    requested_cursor = REGL_CURSOR_CLICKABLE; // set cursor to clickable
+}
+
+// List view class. Renders rows from a data source instead of owning a child object per row.
+class REGL_ListView : public REGL_ChildObject{
+
+    public:
+
+        std::function<int()> row_count; // returns number of rows
+        std::function<std::string(int)> row_at; // returns text of a row
+        std::function<int(int)> row_height_at; // returns height of a row, fixed heights are used if empty
+        std::function<void(int)> on_click; // function called with the clicked row
+        int row_height; // fixed row height
+        int width; // width of the list
+        float text_size; // row text size
+        REGL_Color text_color; // row text color
+        REGL_Color selected_color; // color of the selected row
+        REGL_Font* font = NULL; // row font, default font if NULL
+        int selected_row = -1; // selected row, -1 if none
+        int last_count = 0; // row count when the height index was last updated
+        int last_y = 0; // last y position the list was rendered at
+        std::vector<int> row_offsets; // prefix sums of row heights, only used for variable heights
+        std::vector<REGL_Text> row_pool; // recycled row widgets for the visible range
+        std::vector<int> pool_rows; // row currently bound to each pooled widget
+
+        // custom render function
+        void render(SDL_Renderer* renderer, int x, int y, REGL_Window* window) override;
+
+        // custom clicked function
+        void clicked(SDL_Rect mouse_rect) override;
+
+        // custom hovered function
+        void hovered(SDL_Rect mouse_rect) override;
+
+        // custom collides function
+        bool collides(SDL_Rect other_rect, int x, int y) override;
+
+        // custom layout function
+        void layout(REGL_Window* window) override;
+
+        // custom bounds function
+        SDL_Rect bounds() override;
+
+        // update the height index if the row count changed
+        void updateHeightIndex();
+
+        // rebuild the height index and rebind all rows, call this when the data source changes
+        void refresh();
+
+        // get total height of all rows
+        int totalHeight();
+
+        // get offset of a row from the top of the list
+        int rowOffset(int row);
+
+        // get row at an offset from the top of the list
+        int rowAtOffset(int offset);
+
+        // constructor
+        REGL_ListView(
+            std::function<int()> row_count,
+            std::function<std::string(int)> row_at,
+            std::function<int(int)> row_height_at,
+            std::function<void(int)> on_click,
+            int width, int row_height,
+            float text_size, REGL_Color text_color, REGL_Color selected_color,
+            int nextline, int indent
+        );
+
+};
+
+REGL_ListView::REGL_ListView(
+    std::function<int()> row_count,
+    std::function<std::string(int)> row_at,
+    std::function<int(int)> row_height_at,
+    std::function<void(int)> on_click,
+    int width, int row_height,
+    float text_size, REGL_Color text_color, REGL_Color selected_color,
+    int nextline, int indent
+) : REGL_ChildObject(nextline, indent){
+
+    this->row_count = row_count;
+    this->row_at = row_at;
+    this->row_height_at = row_height_at;
+    this->on_click = on_click;
+    this->width = width;
+    this->row_height = row_height;
+    this->text_size = text_size;
+    this->text_color = text_color;
+    this->selected_color = selected_color;
+
+    updateHeightIndex();
+
+    if (nextline == REGL_NEXTLINE_DEFAULT){
+        decided_nextline = totalHeight() + 10;
+    }
+
+}
+
+void REGL_ListView::updateHeightIndex(){
+
+    int count = row_count();
+    markDirty();
+
+    // fixed heights don't need an index
+    if (!row_height_at){
+        last_count = count;
+        return;
+    }
+
+    // only append offsets of new rows
+    if (row_offsets.empty()){
+        row_offsets.push_back(0);
+        last_count = 0;
+    }
+    if (count < last_count){
+        row_offsets.resize(count + 1);
+    }
+    for (int row = last_count; row < count; row ++){
+        row_offsets.push_back(row_offsets.back() + row_height_at(row));
+    }
+    last_count = count;
+
+}
+
+void REGL_ListView::refresh(){
+
+    // rebuild height index
+    row_offsets.clear();
+    updateHeightIndex();
+
+    // unbind pooled rows so they fetch their text again
+    std::fill(pool_rows.begin(), pool_rows.end(), -1);
+
+}
+
+int REGL_ListView::totalHeight(){
+    return (row_height_at) ? row_offsets.back() : last_count * row_height;
+}
+
+int REGL_ListView::rowOffset(int row){
+    return (row_height_at) ? row_offsets[row] : row * row_height;
+}
+
+int REGL_ListView::rowAtOffset(int offset){
+
+    if (offset < 0 || offset >= totalHeight()){
+        return -1;
+    }
+
+    // fixed heights
+    if (!row_height_at){
+        return offset / row_height;
+    }
+
+    // binary search height index
+    return std::upper_bound(row_offsets.begin(), row_offsets.end(), offset) - row_offsets.begin() - 1;
+
+}
+
+void REGL_ListView::layout(REGL_Window* window){
+
+    // set decided nextline, the height index is updated in render because it calls user functions
+    decided_nextline = totalHeight() + 10;
+
+}
+
+SDL_Rect REGL_ListView::bounds(){
+    return {0, 0, width, totalHeight()};
+}
+
+void REGL_ListView::render(SDL_Renderer* renderer, int x, int y, REGL_Window* window){
+
+    last_y = y;
+
+    // check if row count changed
+    if (row_count() != last_count){
+        updateHeightIndex();
+    }
+
+    if (!last_count){
+        return;
+    }
+
+    // get visible range
+    int first_row = rowAtOffset(regl_max(window->rect.y - y, 0));
+    int last_row = rowAtOffset(regl_min(window->rect.y + window->rect.h - y, totalHeight() - 1));
+    if (first_row == -1 || last_row == -1){
+        return;
+    }
+
+    // grow pool if more rows are visible
+    int visible_rows = last_row - first_row + 1;
+    if (int(row_pool.size()) < visible_rows){
+        row_pool.resize(visible_rows, REGL_Text(" ", false, false, 0, text_size, text_color, 0, 0));
+        std::fill(pool_rows.begin(), pool_rows.end(), -1);
+        pool_rows.resize(visible_rows, -1);
+    }
+
+    for (int row = first_row; row <= last_row; row ++){
+
+        int row_y = y + rowOffset(row);
+
+        // draw selected row
+        if (row == selected_row){
+            SDL_SetRenderDrawColor(renderer, selected_color.r, selected_color.g, selected_color.b, selected_color.a);
+            SDL_FillIncludeRect(renderer, {x, row_y, width, rowOffset(row + 1) - rowOffset(row)}, window->rect);
+        }
+
+        // rebind pooled widget only if it shows another row
+        int slot = row % row_pool.size();
+        if (pool_rows[slot] != row){
+            row_pool[slot].changeText(row_at(row));
+            pool_rows[slot] = row;
+        }
+        row_pool[slot].font = font;
+        row_pool[slot].layout(window);
+
+        row_pool[slot].render(renderer, x, row_y, window);
+
+    }
+
+}
+
+void REGL_ListView::clicked(SDL_Rect mouse_rect){
+
+    int row = rowAtOffset(mouse_rect.y - last_y);
+    if (row == -1){
+        return;
+    }
+
+    // select row
+    selected_row = row;
+
+    // execute function
+    if (on_click){
+        on_click(row);
+    }
+
+}
+
+void REGL_ListView::hovered(SDL_Rect mouse_rect){
+    if (on_click){
+        requested_cursor = REGL_CURSOR_CLICKABLE; // set cursor to clickable
+    }
+}
+
+bool REGL_ListView::collides(SDL_Rect other_rect, int x, int y){
+    last_y = y;
+    SDL_Rect collision_rect = {x, y, width, totalHeight()};
+    return SDL_HasIntersection(&collision_rect, &other_rect);
+}
+
+// Plot class. Plots samples streamed into a ring buffer.
+class REGL_Plot : public REGL_ChildObject{
+
+    public:
+
+        int width, height; // dimensions
+        REGL_Color line_color; // line color
+        REGL_Color background_color; // background color
+        float min_value = 0, max_value = 0; // plotted value range, fitted to the samples if equal
+        size_t visible_samples; // number of newest samples plotted
+        size_t capacity; // number of samples kept
+        size_t block_size = 256; // samples per min/max summary block
+        std::vector<float> samples; // ring buffer of samples
+        std::vector<float> block_min, block_max; // min/max of each block of the ring buffer
+        std::atomic<Uint64> sample_count = 0; // number of samples ever pushed
+        std::mutex samples_mutex; // samples can be pushed from any thread
+        std::vector<SDL_FPoint> points; // decimated line points, relative to the plot
+        std::vector<SDL_FPoint> drawn_points; // line points moved to the render position
+        Uint64 decimated_count = 0; // sample count when points were calculated
+        float decimated_min = 0, decimated_max = 0; // value range when points were calculated
+        size_t decimated_samples = 0; // visible samples when points were calculated
+        int decimated_width = 0, decimated_height = 0; // dimensions when points were calculated
+        std::atomic<bool> decimated = false; // whether points were calculated, reset by clear
+
+        // custom render function
+        void render(SDL_Renderer* renderer, int x, int y, REGL_Window* window) override;
+
+        // custom bounds function
+        SDL_Rect bounds() override;
+
+        // add samples, can be called from any thread
+        void push(float sample);
+        void push(const float* new_samples, size_t new_sample_count);
+
+        // remove all samples
+        void clear();
+
+        // get min and max of samples by their number, samples must still be in the ring buffer
+        void rangeMinMax(Uint64 first, Uint64 last, float& range_min, float& range_max);
+
+        // calculate line points, at most two per pixel column
+        void decimate();
+
+        // constructor
+        REGL_Plot(
+            size_t capacity,
+            int width, int height,
+            REGL_Color line_color, REGL_Color background_color,
+            int nextline, int indent
+        );
+
+};
+
+REGL_Plot::REGL_Plot(
+    size_t capacity,
+    int width, int height,
+    REGL_Color line_color, REGL_Color background_color,
+    int nextline, int indent
+) : REGL_ChildObject(nextline, indent){
+
+    this->capacity = regl_max(capacity, size_t(1));
+    this->visible_samples = this->capacity;
+    this->width = width;
+    this->height = height;
+    this->line_color = line_color;
+    this->background_color = background_color;
+
+    // allocate ring buffer and summaries
+    samples.resize(this->capacity);
+    block_min.resize((this->capacity + block_size - 1) / block_size);
+    block_max.resize(block_min.size());
+
+    if (nextline == REGL_NEXTLINE_DEFAULT){
+        decided_nextline = height + 10;
+    }
+
+}
+
+void REGL_Plot::push(float sample){
+    push(&sample, 1);
+}
+
+void REGL_Plot::push(const float* new_samples, size_t new_sample_count){
+
+    std::lock_guard<std::mutex> lock(samples_mutex);
+
+    for (size_t index = 0; index < new_sample_count; index ++){
+
+        size_t position = sample_count % capacity;
+        float sample = new_samples[index];
+        samples[position] = sample;
+
+        // a block that is written again starts a new summary
+        size_t block = position / block_size;
+        if (position % block_size == 0){
+            block_min[block] = sample;
+            block_max[block] = sample;
+        } else {
+            block_min[block] = regl_min(block_min[block], sample);
+            block_max[block] = regl_max(block_max[block], sample);
+        }
+
+        sample_count ++;
+
+    }
+
+}
+
+void REGL_Plot::clear(){
+    std::lock_guard<std::mutex> lock(samples_mutex);
+    sample_count = 0;
+    decimated = false;
+}
+
+void REGL_Plot::rangeMinMax(Uint64 first, Uint64 last, float& range_min, float& range_max){
+
+    // block being written holds old and new samples, so its summary can't be used
+    size_t write_block = (sample_count % capacity) / block_size;
+
+    while (first < last){
+
+        // scan samples up to the end of the ring buffer
+        size_t position = first % capacity;
+        size_t end_position = regl_min(size_t(position + (last - first)), capacity);
+        first += end_position - position;
+
+        while (position < end_position){
+
+            // use summary of whole blocks
+            size_t block = position / block_size;
+            if (position % block_size == 0 && position + block_size <= end_position && block != write_block){
+                range_min = regl_min(range_min, block_min[block]);
+                range_max = regl_max(range_max, block_max[block]);
+                position += block_size;
+                continue;
+            }
+
+            // scan samples until the next block
+            size_t block_end = regl_min((block + 1) * block_size, end_position);
+            for (; position < block_end; position ++){
+                range_min = regl_min(range_min, samples[position]);
+                range_max = regl_max(range_max, samples[position]);
+            }
+
+        }
+
+    }
+
+}
+
+void REGL_Plot::decimate(){
+
+    std::lock_guard<std::mutex> lock(samples_mutex);
+
+    decimated_count = sample_count;
+    decimated_min = min_value;
+    decimated_max = max_value;
+    decimated_samples = visible_samples;
+    decimated_width = width;
+    decimated_height = height;
+    decimated = true;
+    points.clear();
+
+    // get plotted samples
+    Uint64 plotted = regl_min(decimated_count, Uint64(regl_min(visible_samples, capacity)));
+    if (plotted < 2 || width < 1){
+        return;
+    }
+    Uint64 first = decimated_count - plotted;
+
+    // get min and max of each column
+    int columns = regl_min(Uint64(width), plotted);
+    std::vector<float> column_min(columns), column_max(columns);
+    float plot_min = 0, plot_max = 0;
+    for (int column = 0; column < columns; column ++){
+        float range_min = samples[(first + plotted * column / columns) % capacity];
+        float range_max = range_min;
+        rangeMinMax(first + plotted * column / columns, first + plotted * (column + 1) / columns, range_min, range_max);
+        column_min[column] = range_min;
+        column_max[column] = range_max;
+        plot_min = (column) ? regl_min(plot_min, range_min) : range_min;
+        plot_max = (column) ? regl_max(plot_max, range_max) : range_max;
+    }
+
+    // use set range if there is one
+    if (min_value != max_value){
+        plot_min = min_value;
+        plot_max = max_value;
+    }
+    float value_scale = (plot_max != plot_min) ? (height - 1) / (plot_max - plot_min) : 0;
+    float column_scale = (columns > 1) ? float(width - 1) / (columns - 1) : 0;
+
+    // go down and up in each column, so the line connects to the next column
+    for (int column = 0; column < columns; column ++){
+        float point_x = column * column_scale;
+        float min_y = height - 1 - (column_min[column] - plot_min) * value_scale;
+        float max_y = height - 1 - (column_max[column] - plot_min) * value_scale;
+        bool rising = column % 2;
+        points.push_back({point_x, (rising) ? min_y : max_y});
+        if (column_min[column] != column_max[column]){
+            points.push_back({point_x, (rising) ? max_y : min_y});
+        }
+    }
+
+}
+
+SDL_Rect REGL_Plot::bounds(){
+    return {0, 0, width, height};
+}
+
+void REGL_Plot::render(SDL_Renderer* renderer, int x, int y, REGL_Window* window){
+
+    // draw background
+    SDL_SetRenderDrawColor(renderer, background_color.r, background_color.g, background_color.b, background_color.a);
+    SDL_FillIncludeRect(renderer, {x, y, width, height}, window->rect);
+
+    // only decimate again if samples were pushed or the plotted range or dimensions changed
+    bool range_changed = decimated_min != min_value || decimated_max != max_value || decimated_samples != visible_samples;
+    bool size_changed = decimated_width != width || decimated_height != height;
+    if (!decimated || decimated_count != sample_count || range_changed || size_changed){
+        decimate();
+    }
+
+    // draw all segments at once, clipped to the window
+    SDL_Rect plot_rect = {x, y, width, height};
+    SDL_Rect clip_rect;
+    if (!SDL_IntersectRect(&plot_rect, &window->rect, &clip_rect) || points.size() < 2){
+        return;
+    }
+    drawn_points.resize(points.size());
+    for (size_t index = 0; index < points.size(); index ++){
+        drawn_points[index] = {x + points[index].x, y + points[index].y};
+    }
+    SDL_RenderSetClipRect(renderer, &clip_rect);
+    SDL_SetRenderDrawColor(renderer, line_color.r, line_color.g, line_color.b, line_color.a);
+    SDL_RenderDrawLinesF(renderer, drawn_points.data(), drawn_points.size());
+    SDL_RenderSetClipRect(renderer, NULL);
+
+}
+
+// Text input class. Editable text stored in a gap buffer, only edited lines are placed again.
+class REGL_TextInput : public REGL_ChildObject{
+
+    public:
+
+        REGL_GapBuffer buffer; // text
+        std::vector<size_t> line_starts = {0}; // position of the first character of each line
+        std::vector<std::vector<float>> line_offsets = {{}}; // x of each character of each line at size 1, empty until placed
+        REGL_Font* placed_font = NULL; // font the line offsets were placed with
+        bool multiline; // whether newlines can be typed
+        int width, height; // dimensions
+        float text_size; // text size
+        REGL_Color text_color; // text color
+        REGL_Color background_color; // background color
+        REGL_Color caret_color; // caret color
+        REGL_Color selection_color; // color behind selected text
+        REGL_Font* font = NULL; // text font, default font if NULL
+        std::function<void()> on_change; // function called when the text is edited
+        size_t caret = 0; // caret position
+        size_t selection_anchor = 0; // other end of the selection, same as caret if nothing is selected
+        float preferred_x = -1; // x the caret keeps when moving up and down, -1 if none
+        size_t scroll_line = 0; // first visible line
+        float scroll_x = 0; // horizontal scroll in pixels
+        int last_x = 0, last_y = 0; // last position the text input was rendered at
+        bool dragging = false; // whether a selection is being dragged
+        Uint32 caret_blink_start = 0; // ticks when the caret last moved
+
+        // custom render function
+        void render(SDL_Renderer* renderer, int x, int y, REGL_Window* window) override;
+
+        // custom clicked function
+        void clicked(SDL_Rect mouse_rect) override;
+
+        // custom mouseheld function
+        void mouseHeld(SDL_Rect mouse_rect) override;
+
+        // custom hovered function
+        void hovered(SDL_Rect mouse_rect) override;
+
+        // custom scrolled function
+        void scrolled(SDL_Rect mouse_rect, int scrolled) override;
+        bool consumesScroll(SDL_Rect mouse_rect, int scrolled) override;
+
+        // custom input function
+        void input(const REGL_Event& event) override;
+
+        // custom collides function
+        bool collides(SDL_Rect other_rect, int x, int y) override;
+
+        // custom layout function
+        void layout(REGL_Window* window) override;
+
+        // custom bounds function
+        SDL_Rect bounds() override;
+
+        // get all text
+        std::string getText(){return buffer.text();};
+
+        // replace all text
+        void setText(std::string new_text);
+
+        // replace selection with text, like typing it, returns whether the text changed
+        bool insertText(std::string inserted);
+
+        // erase text between two positions, returns whether the text changed
+        bool eraseText(size_t start, size_t end);
+
+        // remove characters the text input can't show, carriage returns and non ascii bytes, newlines become spaces in single line inputs
+        void filterText(std::string& text);
+
+        // move caret, the selection is kept if extended
+        void moveCaret(size_t position, bool extend_selection);
+
+        // get line of a position
+        size_t lineOf(size_t position);
+
+        // get position after the last character of a line
+        size_t lineEnd(size_t line){return (line + 1 < line_starts.size()) ? line_starts[line + 1] - 1 : buffer.size();};
+
+        // get character offsets of a line, placed if not cached
+        std::vector<float>& lineOffsets(size_t line);
+
+        // get height of a line
+        int lineHeight();
+
+        // get position under the mouse
+        size_t positionAt(SDL_Rect mouse_rect);
+
+        // get position on a line closest to an x at size 1
+        size_t positionAtX(size_t line, float line_x);
+
+        // scroll so the caret is visible
+        void keepCaretVisible();
+
+        // constructor
+        REGL_TextInput(
+            std::string initial_text, bool multiline,
+            int width, int height,
+            float text_size, REGL_Color text_color, REGL_Color background_color,
+            REGL_Color caret_color, REGL_Color selection_color,
+            std::function<void()> on_change,
+            int nextline, int indent
+        );
+
+};
+
+REGL_TextInput::REGL_TextInput(
+    std::string initial_text, bool multiline,
+    int width, int height,
+    float text_size, REGL_Color text_color, REGL_Color background_color,
+    REGL_Color caret_color, REGL_Color selection_color,
+    std::function<void()> on_change,
+    int nextline, int indent
+) : REGL_ChildObject(nextline, indent){
+
+    this->multiline = multiline;
+    this->width = width;
+    this->height = height;
+    this->text_size = text_size;
+    this->text_color = text_color;
+    this->background_color = background_color;
+    this->caret_color = caret_color;
+    this->selection_color = selection_color;
+    this->on_change = on_change;
+
+    setText(initial_text);
+
+    if (nextline == REGL_NEXTLINE_DEFAULT){
+        decided_nextline = height + 10;
+    }
+
+}
+
+void REGL_TextInput::setText(std::string new_text){
+
+    filterText(new_text);
+
+    // index lines
+    buffer = REGL_GapBuffer(new_text);
+    line_starts = {0};
+    for (size_t position = 0; position < new_text.size(); position ++){
+        if (new_text[position] == '\n'){
+            line_starts.push_back(position + 1);
+        }
+    }
+    line_offsets.assign(line_starts.size(), {});
+
+    caret = 0;
+    selection_anchor = 0;
+    scroll_line = 0;
+    scroll_x = 0;
+    markDirty();
+
+}
+
+size_t REGL_TextInput::lineOf(size_t position){
+    return std::upper_bound(line_starts.begin(), line_starts.end(), position) - line_starts.begin() - 1;
+}
+
+std::vector<float>& REGL_TextInput::lineOffsets(size_t line){
+
+    // place all lines again if the font changed
+    if (placed_font != font){
+        for (std::vector<float>& offsets: line_offsets){
+            offsets.clear();
+        }
+        placed_font = font;
+    }
+
+    // place line if not cached
+    std::vector<float>& offsets = line_offsets[line];
+    if (offsets.empty()){
+        placeText(buffer.substr(line_starts[line], lineEnd(line) - line_starts[line]), offsets, font);
+    }
+    return offsets;
+
+}
+
+int REGL_TextInput::lineHeight(){
+    return regl_max(int(textHeight("A", text_size, font)), 1);
+}
+
+void REGL_TextInput::filterText(std::string& text){
+
+    // glyphs are only loaded for ascii characters, and pasted windows text has carriage returns
+    text.erase(std::remove_if(text.begin(), text.end(), [](char character){
+        return character == '\r' || (Uint8(character) & 0x80);
+    }), text.end());
+
+    // single line inputs can't have newlines
+    if (!multiline){
+        std::replace(text.begin(), text.end(), '\n', ' ');
+    }
+
+}
+
+bool REGL_TextInput::insertText(std::string inserted){
+
+    // replace selection
+    filterText(inserted);
+    bool erased = eraseText(regl_min(caret, selection_anchor), regl_max(caret, selection_anchor));
+    if (inserted.empty()){
+        return erased;
+    }
+    size_t position = caret;
+    size_t line = lineOf(position);
+    buffer.insert(position, inserted);
+
+    // move following lines
+    for (size_t following = line + 1; following < line_starts.size(); following ++){
+        line_starts[following] += inserted.size();
+    }
+
+    // add inserted lines
+    std::vector<size_t> inserted_starts;
+    for (size_t index = 0; index < inserted.size(); index ++){
+        if (inserted[index] == '\n'){
+            inserted_starts.push_back(position + index + 1);
+        }
+    }
+    line_starts.insert(line_starts.begin() + line + 1, inserted_starts.begin(), inserted_starts.end());
+    line_offsets.insert(line_offsets.begin() + line + 1, inserted_starts.size(), {});
+
+    // only the edited line is placed again
+    line_offsets[line].clear();
+
+    moveCaret(position + inserted.size(), false);
+    return true;
+
+}
+
+bool REGL_TextInput::eraseText(size_t start, size_t end){
+
+    if (start >= end){
+        return false;
+    }
+
+    // remove lines whose newline is erased
+    size_t first_line = lineOf(start);
+    size_t last_line = lineOf(end);
+    buffer.erase(start, end - start);
+    line_starts.erase(line_starts.begin() + first_line + 1, line_starts.begin() + last_line + 1);
+    line_offsets.erase(line_offsets.begin() + first_line + 1, line_offsets.begin() + last_line + 1);
+
+    // move following lines
+    for (size_t following = first_line + 1; following < line_starts.size(); following ++){
+        line_starts[following] -= end - start;
+    }
+
+    // only the edited line is placed again
+    line_offsets[first_line].clear();
+
+    moveCaret(start, false);
+    return true;
+
+}
+
+void REGL_TextInput::moveCaret(size_t position, bool extend_selection){
+    caret = regl_min(position, buffer.size());
+    if (!extend_selection){
+        selection_anchor = caret;
+    }
+    caret_blink_start = SDL_GetTicks();
+    markDirty();
+}
+
+size_t REGL_TextInput::positionAtX(size_t line, float line_x){
+
+    // find closest character boundary
+    std::vector<float>& offsets = lineOffsets(line);
+    size_t column = std::lower_bound(offsets.begin(), offsets.end(), line_x) - offsets.begin();
+    if (column == offsets.size()){
+        column = offsets.size() - 1;
+    } else if (column && line_x - offsets[column - 1] < offsets[column] - line_x){
+        column -= 1;
+    }
+
+    return line_starts[line] + column;
+
+}
+
+size_t REGL_TextInput::positionAt(SDL_Rect mouse_rect){
+    size_t line = scroll_line + regl_max(mouse_rect.y - last_y, 0) / lineHeight();
+    line = regl_min(line, line_starts.size() - 1);
+    return positionAtX(line, (mouse_rect.x - last_x + scroll_x) / text_size);
+}
+
+void REGL_TextInput::keepCaretVisible(){
+
+    // scroll lines
+    size_t line = lineOf(caret);
+    size_t visible_lines = regl_max(height / lineHeight(), 1);
+    if (line < scroll_line){
+        scroll_line = line;
+    } else if (line >= scroll_line + visible_lines){
+        scroll_line = line - visible_lines + 1;
+    }
+
+    // scroll horizontally
+    float caret_x = lineOffsets(line)[caret - line_starts[line]] * text_size;
+    if (caret_x < scroll_x){
+        scroll_x = caret_x;
+    } else if (caret_x > scroll_x + width - 2){
+        scroll_x = caret_x - width + 2;
+    }
+
+}
+
+void REGL_TextInput::input(const REGL_Event& event){
+
+    size_t selection_start = regl_min(caret, selection_anchor);
+    size_t selection_end = regl_max(caret, selection_anchor);
+    bool edited = false;
+
+    // type text
+    if (event.type == REGL_EVENT_TEXT_INPUT){
+        edited = insertText(event.text);
+    }
+
+    if (event.type == REGL_EVENT_KEY_DOWN){
+
+        bool shift = event.modifiers & KMOD_SHIFT;
+        bool ctrl = event.modifiers & KMOD_CTRL;
+        size_t line = lineOf(caret);
+
+        // only up and down keep the caret x
+        float caret_x = (preferred_x >= 0) ? preferred_x : lineOffsets(line)[caret - line_starts[line]];
+        preferred_x = -1;
+
+        if (event.key == SDLK_BACKSPACE){
+            edited = eraseText((selection_start == selection_end && selection_start) ? selection_start - 1 : selection_start, selection_end);
+        } else if (event.key == SDLK_DELETE){
+            edited = eraseText(selection_start, (selection_start == selection_end) ? regl_min(selection_end + 1, buffer.size()) : selection_end);
+        } else if (event.key == SDLK_LEFT){
+            moveCaret((selection_start != selection_end && !shift) ? selection_start : (caret) ? caret - 1 : 0, shift);
+        } else if (event.key == SDLK_RIGHT){
+            moveCaret((selection_start != selection_end && !shift) ? selection_end : caret + 1, shift);
+        } else if (event.key == SDLK_UP){
+            moveCaret((line) ? positionAtX(line - 1, caret_x) : 0, shift);
+            preferred_x = caret_x;
+        } else if (event.key == SDLK_DOWN){
+            moveCaret((line + 1 < line_starts.size()) ? positionAtX(line + 1, caret_x) : buffer.size(), shift);
+            preferred_x = caret_x;
+        } else if (event.key == SDLK_HOME){
+            moveCaret(line_starts[line], shift);
+        } else if (event.key == SDLK_END){
+            moveCaret(lineEnd(line), shift);
+        } else if ((event.key == SDLK_RETURN || event.key == SDLK_KP_ENTER) && multiline){
+            edited = insertText("\n");
+        } else if (event.key == SDLK_a && ctrl){
+            selection_anchor = 0;
+            moveCaret(buffer.size(), true);
+        } else if ((event.key == SDLK_c || event.key == SDLK_x) && ctrl && selection_start != selection_end){
+            SDL_SetClipboardText(buffer.substr(selection_start, selection_end - selection_start).c_str());
+            if (event.key == SDLK_x){
+                edited = eraseText(selection_start, selection_end);
+            }
+        } else if (event.key == SDLK_v && ctrl && SDL_HasClipboardText()){
+            char* clipboard_text = SDL_GetClipboardText();
+            edited = insertText(clipboard_text);
+            SDL_free(clipboard_text);
+        }
+
+    }
+
+    keepCaretVisible();
+
+    // execute function
+    if (edited && on_change){
+        on_change();
+    }
+
+}
+
+void REGL_TextInput::clicked(SDL_Rect mouse_rect){
+    moveCaret(positionAt(mouse_rect), false);
+    preferred_x = -1;
+    dragging = true;
+}
+
+void REGL_TextInput::mouseHeld(SDL_Rect mouse_rect){
+    // extend selection while dragging
+    if (dragging){
+        moveCaret(positionAt(mouse_rect), true);
+    }
+}
+
+void REGL_TextInput::hovered(SDL_Rect mouse_rect){
+    requested_cursor = REGL_CURSOR_TEXT; // set cursor to text
+}
+
+void REGL_TextInput::scrolled(SDL_Rect mouse_rect, int scrolled){
+    scroll_line = regl_min(size_t(regl_max(int(scroll_line) + scrolled * 3, 0)), line_starts.size() - 1);
+}
+bool REGL_TextInput::consumesScroll(SDL_Rect mouse_rect, int scrolled){
+    return (scrolled < 0) ? scroll_line > 0 : scroll_line + 1 < line_starts.size();
+}
+
+bool REGL_TextInput::collides(SDL_Rect other_rect, int x, int y){
+    last_x = x;
+    last_y = y;
+    SDL_Rect collision_rect = {x, y, width, height};
+    return SDL_HasIntersection(&collision_rect, &other_rect);
+}
+
+void REGL_TextInput::layout(REGL_Window* window){
+    decided_nextline = height + 10;
+}
+
+SDL_Rect REGL_TextInput::bounds(){
+    return {0, 0, width, height};
+}
+
+void REGL_TextInput::render(SDL_Renderer* renderer, int x, int y, REGL_Window* window){
+
+    last_x = x;
+    last_y = y;
+
+    // stop dragging when released
+    if (!mouse_held){
+        dragging = false;
+    }
+
+    // draw background
+    SDL_SetRenderDrawColor(renderer, background_color.r, background_color.g, background_color.b, background_color.a);
+    SDL_FillIncludeRect(renderer, {x, y, width, height}, window->rect);
+
+    // crop text to the text input and the window
+    SDL_Rect input_rect = {x, y, width, height};
+    SDL_Rect include_rect;
+    if (!SDL_IntersectRect(&input_rect, &window->rect, &include_rect)){
+        return;
+    }
+
+    int line_height = lineHeight();
+    size_t selection_start = regl_min(caret, selection_anchor);
+    size_t selection_end = regl_max(caret, selection_anchor);
+    size_t last_line = regl_min(scroll_line + height / line_height + 1, line_starts.size());
+
+    // only visible lines are drawn
+    for (size_t line = scroll_line; line < last_line; line ++){
+
+        std::vector<float>& offsets = lineOffsets(line);
+        size_t line_start = line_starts[line];
+        size_t line_end = lineEnd(line);
+        int line_y = y + (line - scroll_line) * line_height;
+
+        // draw selection, selected newlines are shown as a small space
+        if (selection_start <= line_end && selection_end > line_start){
+            size_t first_column = regl_max(selection_start, line_start) - line_start;
+            size_t last_column = regl_min(selection_end, line_end) - line_start;
+            float selection_x = offsets[first_column] * text_size - scroll_x;
+            float selection_width = (offsets[last_column] - offsets[first_column]) * text_size;
+            if (selection_end > line_end){
+                selection_width += text_size * 5;
+            }
+            SDL_SetRenderDrawColor(renderer, selection_color.r, selection_color.g, selection_color.b, selection_color.a);
+            SDL_FillIncludeRect(renderer, {int(x + selection_x), line_y, int(selection_width + 0.5f), line_height}, include_rect);
+        }
+
+        // draw characters inside the text input
+        size_t column = std::upper_bound(offsets.begin(), offsets.end(), scroll_x / text_size) - offsets.begin();
+        column = (column) ? column - 1 : 0;
+        for (; column + 1 < offsets.size(); column ++){
+            float character_x = offsets[column] * text_size - scroll_x;
+            if (character_x > width){
+                break;
+            }
+            getCharacter(buffer.at(line_start + column), font).render(
+                renderer, int(x + character_x + 0.5f), line_y, text_size, include_rect, text_color
+            );
+        }
+
+    }
+
+    // draw blinking caret if focused
+    if (window->focused_child == this && (SDL_GetTicks() - caret_blink_start) / 500 % 2 == 0){
+        size_t line = lineOf(caret);
+        if (line >= scroll_line && line < last_line){
+            float caret_x = lineOffsets(line)[caret - line_starts[line]] * text_size - scroll_x;
+            SDL_SetRenderDrawColor(renderer, caret_color.r, caret_color.g, caret_color.b, caret_color.a);
+            SDL_FillIncludeRect(renderer, {int(x + caret_x), int(y + (line - scroll_line) * line_height), 2, line_height}, include_rect);
+        }
+    }
+
+}
+
+// Measured and truncated text of a table cell.
+class _CachedCell{
+
+    public:
+
+        std::string text; // truncated text
+        std::vector<float> offsets; // character offsets at size 1
+
+};
+
+// Table class. Shows cells of a data source, only the visible rows and columns are rendered.
+class REGL_Table : public REGL_ChildObject{
+
+    public:
+
+        std::vector<std::string> column_names; // header text of each column
+        std::vector<int> column_widths; // width of each column
+        std::vector<int> column_offsets = {0}; // prefix sums of column widths
+        std::function<int()> row_count; // returns number of rows
+        std::function<std::string(int, int)> cell_at; // returns text of a cell by row and column
+        std::function<void(int)> on_click; // function called with the clicked row of the data source
+        int width; // visible width, columns outside are scrolled
+        int row_height; // row height, also used for the header
+        float text_size; // text size
+        REGL_Color text_color; // text color
+        REGL_Color header_color; // header background color
+        REGL_Color selected_color; // color of the selected row
+        REGL_Font* font = NULL; // text font, default font if NULL
+        int selected_row = -1; // selected row of the data source, -1 if none
+        int sort_column = -1; // column rows are sorted by, -1 if unsorted
+        bool sort_ascending = true; // sort direction
+        std::vector<int> permutation; // row of the data source shown in each table row
+        std::vector<std::string> sort_keys; // text of the sort column of each data row, empty if unsorted
+        std::vector<double> number_sort_keys; // sort keys as numbers
+        bool numbers_sorted = false; // whether all sort keys are numbers, so they are compared as numbers
+        int last_count = 0; // row count when the permutation was built
+        int scroll_x = 0; // horizontal scroll in pixels
+        int last_x = 0, last_y = 0; // last position the table was rendered at
+        std::unordered_map<Uint64, _CachedCell> cell_cache; // truncated cells by data row and column
+        size_t cell_cache_size = 65536; // number of cells kept before the cache is cleared
+
+        // custom render function
+        void render(SDL_Renderer* renderer, int x, int y, REGL_Window* window) override;
+
+        // custom clicked function
+        void clicked(SDL_Rect mouse_rect) override;
+
+        // custom hovered function
+        void hovered(SDL_Rect mouse_rect) override;
+
+        // custom scrolled function
+        void scrolled(SDL_Rect mouse_rect, int scrolled) override;
+        bool consumesScroll(SDL_Rect mouse_rect, int scrolled) override;
+
+        // custom collides function
+        bool collides(SDL_Rect other_rect, int x, int y) override;
+
+        // custom layout function
+        void layout(REGL_Window* window) override;
+
+        // custom bounds function
+        SDL_Rect bounds() override;
+
+        // sort rows by a column, -1 shows rows unsorted
+        void sortBy(int column, bool ascending);
+
+        // get cells again, call this when the data source changes
+        void refresh();
+
+        // follow a changed row count, rows are only added or removed at the end so other rows keep their cells and order
+        void changeRowCount(int new_count);
+
+        // get sort keys of data rows from first_row on
+        void addSortKeys(int first_row);
+
+        // whether a data row is shown before another in the current sort
+        bool sortsBefore(int first, int second);
+
+        // change width of a column
+        void setColumnWidth(int column, int column_width);
+
+        // get column at an x from the left of the columns, -1 if none
+        int columnAt(int column_x);
+
+        // get truncated cell, measured if not cached
+        _CachedCell& getCell(int data_row, int column);
+
+        // get total height of header and rows
+        int totalHeight(){return (last_count + 1) * row_height;};
+
+        // constructor
+        REGL_Table(
+            std::vector<std::string> column_names, std::vector<int> column_widths,
+            std::function<int()> row_count,
+            std::function<std::string(int, int)> cell_at,
+            std::function<void(int)> on_click,
+            int width, int row_height,
+            float text_size, REGL_Color text_color, REGL_Color header_color, REGL_Color selected_color,
+            int nextline, int indent
+        );
+
+};
+
+REGL_Table::REGL_Table(
+    std::vector<std::string> column_names, std::vector<int> column_widths,
+    std::function<int()> row_count,
+    std::function<std::string(int, int)> cell_at,
+    std::function<void(int)> on_click,
+    int width, int row_height,
+    float text_size, REGL_Color text_color, REGL_Color header_color, REGL_Color selected_color,
+    int nextline, int indent
+) : REGL_ChildObject(nextline, indent){
+
+    this->column_names = column_names;
+    this->column_widths = column_widths;
+    this->row_count = row_count;
+    this->cell_at = cell_at;
+    this->on_click = on_click;
+    this->width = width;
+    this->row_height = row_height;
+    this->text_size = text_size;
+    this->text_color = text_color;
+    this->header_color = header_color;
+    this->selected_color = selected_color;
+
+    // every column needs a width
+    this->column_widths.resize(column_names.size(), 100);
+    for (size_t column = 0; column < this->column_widths.size(); column ++){
+        setColumnWidth(column, this->column_widths[column]);
+    }
+
+    refresh();
+
+    if (nextline == REGL_NEXTLINE_DEFAULT){
+        decided_nextline = totalHeight() + 10;
+    }
+
+}
+
+void REGL_Table::setColumnWidth(int column, int column_width){
+
+    if (column < 0 || column >= int(column_widths.size())){
+        return;
+    }
+    column_widths[column] = column_width;
+
+    // rebuild prefix sums
+    column_offsets.assign(column_widths.size() + 1, 0);
+    for (size_t index = 0; index < column_widths.size(); index ++){
+        column_offsets[index + 1] = column_offsets[index] + column_widths[index];
+    }
+
+    // cells are truncated to the column width
+    cell_cache.clear();
+
+}
+
+int REGL_Table::columnAt(int column_x){
+    if (column_x < 0 || column_x >= column_offsets.back()){
+        return -1;
+    }
+    return std::upper_bound(column_offsets.begin(), column_offsets.end(), column_x) - column_offsets.begin() - 1;
+}
+
+void REGL_Table::refresh(){
+    markDirty();
+    cell_cache.clear();
+    last_count = row_count();
+    sortBy(sort_column, sort_ascending);
+}
+
+void REGL_Table::sortBy(int column, bool ascending){
+
+    sort_column = (column >= 0 && column < int(column_names.size())) ? column : -1;
+    sort_ascending = ascending;
+
+    // unsorted rows are in data source order
+    permutation.resize(last_count);
+    for (int row = 0; row < last_count; row ++){
+        permutation[row] = row;
+    }
+    sort_keys.clear();
+    number_sort_keys.clear();
+    if (sort_column == -1){
+        return;
+    }
+
+    // get each key once and sort rows without moving data
+    numbers_sorted = true;
+    addSortKeys(0);
+    std::stable_sort(permutation.begin(), permutation.end(), [this](int first, int second){return sortsBefore(first, second);});
+
+}
+
+void REGL_Table::addSortKeys(int first_row){
+
+    // numbers are compared as numbers
+    sort_keys.resize(last_count);
+    number_sort_keys.resize(last_count);
+    for (int row = first_row; row < last_count; row ++){
+        sort_keys[row] = cell_at(row, sort_column);
+        char* number_end;
+        number_sort_keys[row] = strtod(sort_keys[row].c_str(), &number_end);
+        numbers_sorted = numbers_sorted && !sort_keys[row].empty() && *number_end == '\0';
+    }
+
+}
+
+bool REGL_Table::sortsBefore(int first, int second){
+    if (numbers_sorted){
+        return (sort_ascending) ? number_sort_keys[first] < number_sort_keys[second] : number_sort_keys[second] < number_sort_keys[first];
+    }
+    return (sort_ascending) ? sort_keys[first] < sort_keys[second] : sort_keys[second] < sort_keys[first];
+}
+
+void REGL_Table::changeRowCount(int new_count){
+
+    markDirty();
+    int old_count = last_count;
+    last_count = new_count;
+
+    // removed rows, the others keep their order and cells
+    if (new_count < old_count){
+        permutation.erase(std::remove_if(permutation.begin(), permutation.end(), [new_count](int row){return row >= new_count;}), permutation.end());
+        if (sort_column != -1){
+            sort_keys.resize(new_count);
+            number_sort_keys.resize(new_count);
+        }
+        for (auto cell = cell_cache.begin(); cell != cell_cache.end();){
+            cell = (int(cell->first >> 32) >= new_count) ? cell_cache.erase(cell) : std::next(cell);
+        }
+        return;
+    }
+
+    // added rows go after the others if unsorted
+    for (int row = old_count; row < new_count; row ++){
+        permutation.push_back(row);
+    }
+    if (sort_column == -1){
+        return;
+    }
+
+    // sort all rows again if the keys stopped being numbers, otherwise only sort added rows and merge them in
+    bool were_numbers = numbers_sorted;
+    addSortKeys(old_count);
+    if (were_numbers && !numbers_sorted){
+        sortBy(sort_column, sort_ascending);
+        return;
+    }
+    auto sorts_before = [this](int first, int second){return sortsBefore(first, second);};
+    std::stable_sort(permutation.begin() + old_count, permutation.end(), sorts_before);
+    std::inplace_merge(permutation.begin(), permutation.begin() + old_count, permutation.end(), sorts_before);
+
+}
+
+_CachedCell& REGL_Table::getCell(int data_row, int column){
+
+    // check if cached
+    Uint64 key = (Uint64(data_row) << 32) | Uint32(column);
+    auto found = cell_cache.find(key);
+    if (found != cell_cache.end()){
+        return found->second;
+    }
+
+    // keep cache bounded
+    if (cell_cache.size() >= cell_cache_size){
+        cell_cache.clear();
+    }
+
+    // measure cell
+    _CachedCell& cell = cell_cache[key];
+    cell.text = (data_row == -1) ? column_names[column] : cell_at(data_row, column);
+    placeText(cell.text, cell.offsets, font);
+
+    // truncate with dots if too wide
+    float available_width = (column_widths[column] - 8) / text_size;
+    if (cell.offsets.back() > available_width){
+        std::vector<float> dots_offsets;
+        placeText("...", dots_offsets, font);
+        int kept = std::upper_bound(cell.offsets.begin(), cell.offsets.end(), available_width - dots_offsets.back()) - cell.offsets.begin() - 1;
+        cell.text = cell.text.substr(0, regl_max(kept, 0)) + "...";
+        placeText(cell.text, cell.offsets, font);
+    }
+
+    return cell;
+
+}
+
+void REGL_Table::layout(REGL_Window* window){
+
+    // set decided nextline, the row count is polled in render because it calls user functions
+    decided_nextline = totalHeight() + 10;
+
+}
+
+SDL_Rect REGL_Table::bounds(){
+    return {0, 0, width, totalHeight()};
+}
+
+void REGL_Table::render(SDL_Renderer* renderer, int x, int y, REGL_Window* window){
+
+    last_x = x;
+    last_y = y;
+
+    // follow added and removed rows
+    int new_count = row_count();
+    if (new_count != last_count){
+        changeRowCount(new_count);
+    }
+
+    // crop to the table and the window
+    SDL_Rect table_rect = {x, y, width, totalHeight()};
+    SDL_Rect include_rect;
+    if (!SDL_IntersectRect(&table_rect, &window->rect, &include_rect)){
+        return;
+    }
+
+    // get visible columns
+    int first_column = columnAt(regl_max(scroll_x, 0));
+    if (first_column == -1){
+        return;
+    }
+
+    // get visible rows, -1 is the header
+    int first_row = regl_max((include_rect.y - y) / row_height - 1, -1);
+    int last_row = regl_min((include_rect.y + include_rect.h - y) / row_height - 1, last_count - 1);
+
+    // draw header background
+    SDL_SetRenderDrawColor(renderer, header_color.r, header_color.g, header_color.b, header_color.a);
+    SDL_FillIncludeRect(renderer, {x, y, width, row_height}, include_rect);
+
+    for (int row = first_row; row <= last_row; row ++){
+
+        int row_y = y + (row + 1) * row_height;
+        int data_row = (row == -1) ? -1 : permutation[row];
+
+        // draw selected row
+        if (data_row != -1 && data_row == selected_row){
+            SDL_SetRenderDrawColor(renderer, selected_color.r, selected_color.g, selected_color.b, selected_color.a);
+            SDL_FillIncludeRect(renderer, {x, row_y, width, row_height}, include_rect);
+        }
+
+        // draw visible cells
+        for (int column = first_column; column < int(column_widths.size()); column ++){
+
+            int cell_x = x + column_offsets[column] - scroll_x;
+            if (cell_x >= x + width){
+                break;
+            }
+
+            // crop cell to its column
+            SDL_Rect cell_rect = {cell_x, row_y, column_widths[column], row_height};
+            SDL_Rect cell_include_rect;
+            if (!SDL_IntersectRect(&cell_rect, &include_rect, &cell_include_rect)){
+                continue;
+            }
+
+            _CachedCell& cell = getCell(data_row, column);
+            renderPlacedText(renderer, text_color, cell.text, cell.offsets, cell_x + 4, row_y, text_size, cell_include_rect, font);
+
+        }
+
+    }
+
+}
+
+void REGL_Table::clicked(SDL_Rect mouse_rect){
+
+    // sort by clicked header, clicking again changes direction
+    int row = (mouse_rect.y - last_y) / row_height - 1;
+    if (row == -1){
+        int column = columnAt(mouse_rect.x - last_x + scroll_x);
+        if (column != -1){
+            sortBy(column, (column == sort_column) ? !sort_ascending : true);
+        }
+        return;
+    }
+
+    if (row < 0 || row >= last_count){
+        return;
+    }
+
+    // select row
+    selected_row = permutation[row];
+
+    // execute function
+    if (on_click){
+        on_click(selected_row);
+    }
+
+}
+
+void REGL_Table::hovered(SDL_Rect mouse_rect){
+    if (mouse_rect.y - last_y < row_height || on_click){
+        requested_cursor = REGL_CURSOR_CLICKABLE; // set cursor to clickable
+    }
+}
+
+void REGL_Table::scrolled(SDL_Rect mouse_rect, int scrolled){
+    // scroll columns when scrolled over the header
+    if (mouse_rect.y - last_y < row_height){
+        scroll_x = regl_max(regl_min(scroll_x + scrolled * 40, column_offsets.back() - width), 0);
+    }
+}
+bool REGL_Table::consumesScroll(SDL_Rect mouse_rect, int scrolled){
+    if (mouse_rect.y - last_y >= row_height){
+        return false;
+    }
+    return (scrolled < 0) ? scroll_x > 0 : scroll_x < column_offsets.back() - width;
+}
+
+bool REGL_Table::collides(SDL_Rect other_rect, int x, int y){
+    last_x = x;
+    last_y = y;
+    SDL_Rect collision_rect = {x, y, width, totalHeight()};
+    return SDL_HasIntersection(&collision_rect, &other_rect);
+}
+
+// Visible row of a tree view.
+class _TreeRow{
+
+    public:
+
+        Uint64 node; // node id
+        int depth; // number of parents
+        bool expanded; // whether children are shown
+        bool has_children; // whether the node can be expanded
+        std::string text; // node text
+
+};
+
+// Tree view class. Children of nodes are only asked for when the node is expanded.
+class REGL_TreeView : public REGL_ChildObject{
+
+    public:
+
+        Uint64 root; // node whose children are the top rows
+        std::function<std::vector<Uint64>(Uint64)> children_of; // returns children of a node
+        std::function<std::string(Uint64)> node_text; // returns text of a node
+        std::function<bool(Uint64)> has_children; // returns whether a node has children, nodes can always be expanded if empty
+        std::function<void(Uint64)> on_click; // function called with the clicked node
+        int width; // width of the tree view
+        int row_height; // row height
+        int indent_width; // indentation per depth
+        float text_size; // text size
+        REGL_Color text_color; // text color
+        REGL_Color selected_color; // color of the selected row
+        REGL_Font* font = NULL; // text font, default font if NULL
+        Uint64 selected_node = 0; // selected node
+        bool has_selection = false; // whether a node is selected
+        std::vector<_TreeRow> rows; // visible rows, in order
+        int last_y = 0; // last y position the tree view was rendered at
+        int last_x = 0; // last x position the tree view was rendered at
+
+        // custom render function
+        void render(SDL_Renderer* renderer, int x, int y, REGL_Window* window) override;
+
+        // custom clicked function
+        void clicked(SDL_Rect mouse_rect) override;
+
+        // custom hovered function
+        void hovered(SDL_Rect mouse_rect) override;
+
+        // custom collides function
+        bool collides(SDL_Rect other_rect, int x, int y) override;
+
+        // custom layout function
+        void layout(REGL_Window* window) override;
+
+        // custom bounds function
+        SDL_Rect bounds() override;
+
+        // show children of a row
+        void expand(int row);
+
+        // hide children of a row
+        void collapse(int row);
+
+        // expand or collapse a row
+        void toggle(int row);
+
+        // collapse everything and get the top rows again, call this when the data source changes
+        void refresh();
+
+        // get total height of visible rows
+        int totalHeight(){return rows.size() * row_height;};
+
+        // constructor
+        REGL_TreeView(
+            Uint64 root,
+            std::function<std::vector<Uint64>(Uint64)> children_of,
+            std::function<std::string(Uint64)> node_text,
+            std::function<bool(Uint64)> has_children,
+            std::function<void(Uint64)> on_click,
+            int width, int row_height, int indent_width,
+            float text_size, REGL_Color text_color, REGL_Color selected_color,
+            int nextline, int indent
+        );
+
+};
+
+REGL_TreeView::REGL_TreeView(
+    Uint64 root,
+    std::function<std::vector<Uint64>(Uint64)> children_of,
+    std::function<std::string(Uint64)> node_text,
+    std::function<bool(Uint64)> has_children,
+    std::function<void(Uint64)> on_click,
+    int width, int row_height, int indent_width,
+    float text_size, REGL_Color text_color, REGL_Color selected_color,
+    int nextline, int indent
+) : REGL_ChildObject(nextline, indent){
+
+    this->root = root;
+    this->children_of = children_of;
+    this->node_text = node_text;
+    this->has_children = has_children;
+    this->on_click = on_click;
+    this->width = width;
+    this->row_height = row_height;
+    this->indent_width = indent_width;
+    this->text_size = text_size;
+    this->text_color = text_color;
+    this->selected_color = selected_color;
+
+    refresh();
+
+    if (nextline == REGL_NEXTLINE_DEFAULT){
+        decided_nextline = totalHeight() + 10;
+    }
+
+}
+
+void REGL_TreeView::refresh(){
+    rows.clear();
+    for (Uint64 node: children_of(root)){
+        rows.push_back({node, 0, false, (has_children) ? has_children(node) : true, node_text(node)});
+    }
+    markDirty();
+}
+
+void REGL_TreeView::expand(int row){
+
+    if (row < 0 || row >= int(rows.size()) || rows[row].expanded || !rows[row].has_children){
+        return;
+    }
+
+    // get children now
+    std::vector<Uint64> children = children_of(rows[row].node);
+    rows[row].expanded = true;
+    if (children.empty()){
+        rows[row].has_children = false;
+        return;
+    }
+
+    // insert children after the row
+    std::vector<_TreeRow> child_rows;
+    child_rows.reserve(children.size());
+    for (Uint64 child: children){
+        child_rows.push_back({child, rows[row].depth + 1, false, (has_children) ? has_children(child) : true, node_text(child)});
+    }
+    rows.insert(rows.begin() + row + 1, std::make_move_iterator(child_rows.begin()), std::make_move_iterator(child_rows.end()));
+    markDirty();
+
+}
+
+void REGL_TreeView::collapse(int row){
+
+    if (row < 0 || row >= int(rows.size()) || !rows[row].expanded){
+        return;
+    }
+    rows[row].expanded = false;
+
+    // erase rows deeper than the row that follow it
+    int end_row = row + 1;
+    while (end_row < int(rows.size()) && rows[end_row].depth > rows[row].depth){
+        end_row ++;
+    }
+    rows.erase(rows.begin() + row + 1, rows.begin() + end_row);
+    markDirty();
+
+}
+
+void REGL_TreeView::toggle(int row){
+    if (row >= 0 && row < int(rows.size()) && rows[row].expanded){
+        collapse(row);
+    } else {
+        expand(row);
+    }
+}
+
+void REGL_TreeView::layout(REGL_Window* window){
+    decided_nextline = totalHeight() + 10;
+}
+
+SDL_Rect REGL_TreeView::bounds(){
+    return {0, 0, width, totalHeight()};
+}
+
+void REGL_TreeView::render(SDL_Renderer* renderer, int x, int y, REGL_Window* window){
+
+    last_x = x;
+    last_y = y;
+
+    if (rows.empty()){
+        return;
+    }
+
+    // get visible range
+    int first_row = regl_max(window->rect.y - y, 0) / row_height;
+    int last_row = regl_min((window->rect.y + window->rect.h - y) / row_height, int(rows.size()) - 1);
+
+    for (int row = first_row; row <= last_row; row ++){
+
+        _TreeRow& tree_row = rows[row];
+        int row_y = y + row * row_height;
+        int row_x = x + tree_row.depth * indent_width;
+
+        // draw selected row
+        if (has_selection && tree_row.node == selected_node){
+            SDL_SetRenderDrawColor(renderer, selected_color.r, selected_color.g, selected_color.b, selected_color.a);
+            SDL_FillIncludeRect(renderer, {x, row_y, width, row_height}, window->rect);
+        }
+
+        // draw expander
+        if (tree_row.has_children){
+            renderText(renderer, text_color, (tree_row.expanded) ? "-" : "+", row_x, row_y, text_size, 10000, window->rect, font);
+        }
+
+        // draw text
+        renderText(renderer, text_color, tree_row.text, row_x + indent_width, row_y, text_size, x + width - row_x - indent_width, window->rect, font);
+
+    }
+
+}
+
+void REGL_TreeView::clicked(SDL_Rect mouse_rect){
+
+    int row = (mouse_rect.y - last_y) / row_height;
+    if (row < 0 || row >= int(rows.size())){
+        return;
+    }
+
+    // toggle if clicked on the expander
+    int row_x = last_x + rows[row].depth * indent_width;
+    if (mouse_rect.x >= row_x && mouse_rect.x < row_x + indent_width){
+        toggle(row);
+        return;
+    }
+
+    // select node
+    selected_node = rows[row].node;
+    has_selection = true;
+
+    // execute function
+    if (on_click){
+        on_click(selected_node);
+    }
+
+}
+
+void REGL_TreeView::hovered(SDL_Rect mouse_rect){
+    requested_cursor = REGL_CURSOR_CLICKABLE; // set cursor to clickable
+}
+
+bool REGL_TreeView::collides(SDL_Rect other_rect, int x, int y){
+    last_x = x;
+    last_y = y;
+    SDL_Rect collision_rect = {x, y, width, totalHeight()};
+    return SDL_HasIntersection(&collision_rect, &other_rect);
+}
+
+// Image class. Draws the mip level of an image closest to its size, so downscaled images don't alias.
+class REGL_Image : public REGL_ChildObject{
+
+    public:
+
+        std::string path; // image path
+        int width, height; // dimensions
+        REGL_Color color = REGL_COLOR_WHITE; // color mod
+        REGL_MipTexture texture; // mip levels of the image
+
+        // custom render function
+        void render(SDL_Renderer* renderer, int x, int y, REGL_Window* window) override;
+
+        // custom bounds function
+        SDL_Rect bounds() override;
+
+        // change image and size
+        void changeImage(std::string new_path);
+        void resize(int new_width, int new_height);
+
+        // constructor
+        REGL_Image(
+            std::string path,
+            int width, int height,
+            int nextline, int indent
+        );
+
+};
+
+REGL_Image::REGL_Image(
+    std::string path,
+    int width, int height,
+    int nextline, int indent
+) : REGL_ChildObject(nextline, indent){
+
+    this->path = path;
+    this->width = width;
+    this->height = height;
+    texture = REGL_MipTexture(path);
+
+    if (nextline == REGL_NEXTLINE_DEFAULT){
+        decided_nextline = height + 10;
+    }
+
+}
+
+void REGL_Image::changeImage(std::string new_path){
+    if (new_path == path){
+        return;
+    }
+    path = new_path;
+    texture = REGL_MipTexture(new_path);
+}
+
+void REGL_Image::resize(int new_width, int new_height){
+    width = new_width;
+    height = new_height;
+    if (nextline == REGL_NEXTLINE_DEFAULT){
+        decided_nextline = height + 10;
+    }
+    markDirty();
+}
+
+SDL_Rect REGL_Image::bounds(){
+    return {0, 0, width, height};
+}
+
+void REGL_Image::render(SDL_Renderer* renderer, int x, int y, REGL_Window* window){
+
+    // draw the mip level closest to the image size, levels are loaded in the background
+    texture.render(renderer, {x, y, width, height}, window->rect, color);
+
+}
+
+// Canvas class. Pixels are written into a shadow buffer from any thread, only the changed rect is uploaded to a streaming texture.
+class REGL_Canvas : public REGL_ChildObject{
+
+    public:
+
+        int width, height; // dimensions
+        int canvas_width, canvas_height; // number of pixels
+        std::vector<Uint32> pixels; // ARGB8888 shadow buffer
+        Uint32 palette[256]; // colors of cell values
+        SDL_Rect dirty_rect = {0, 0, 0, 0}; // union of changed rects, empty if nothing changed
+        std::mutex pixels_mutex; // pixels can be written from any thread
+        SDL_Texture* texture = NULL; // streaming texture, created on first render
+
+        // custom render function
+        void render(SDL_Renderer* renderer, int x, int y, REGL_Window* window) override;
+
+        // custom bounds function
+        SDL_Rect bounds() override;
+
+        // lock a rect of pixels for writing, returns the first pixel of the rect, rows are pitch pixels apart
+        // the rect is clipped to the canvas, must be unlocked before the next lock
+        Uint32* lockPixels(SDL_Rect& rect, int& pitch);
+        void unlockPixels();
+
+        // write pixels or cell values, can be called from any thread
+        void setPixel(int x, int y, REGL_Color color);
+        void fill(SDL_Rect rect, REGL_Color color);
+        void setCells(SDL_Rect rect, const Uint8* values);
+
+        // change colors of cell values, does not change cells already written
+        void setPalette(const std::vector<REGL_Color>& colors);
+        void setGradient(REGL_Color low_color, REGL_Color high_color);
+
+        // constructor
+        REGL_Canvas(
+            int canvas_width, int canvas_height,
+            int width, int height,
+            int nextline, int indent
+        );
+
+        // destructor
+        ~REGL_Canvas();
+
+};
+
+// Pack a color into an ARGB8888 pixel.
+Uint32 _packPixel(REGL_Color color){
+    return (Uint32(color.a) << 24) | (Uint32(color.r) << 16) | (Uint32(color.g) << 8) | Uint32(color.b);
+}
+
+REGL_Canvas::REGL_Canvas(
+    int canvas_width, int canvas_height,
+    int width, int height,
+    int nextline, int indent
+) : REGL_ChildObject(nextline, indent){
+
+    this->canvas_width = regl_max(canvas_width, 1);
+    this->canvas_height = regl_max(canvas_height, 1);
+    this->width = width;
+    this->height = height;
+    pixels.resize(this->canvas_width * this->canvas_height, 0);
+    setGradient({0, 0, 0, 255}, {255, 255, 255, 255});
+
+    if (nextline == REGL_NEXTLINE_DEFAULT){
+        decided_nextline = height + 10;
+    }
+
+}
+
+REGL_Canvas::~REGL_Canvas(){
+    if (texture){
+        SDL_DestroyTexture(texture);
+    }
+}
+
+Uint32* REGL_Canvas::lockPixels(SDL_Rect& rect, int& pitch){
+
+    pixels_mutex.lock();
+
+    // clip to canvas
+    SDL_Rect canvas_rect = {0, 0, canvas_width, canvas_height};
+    if (!SDL_IntersectRect(&rect, &canvas_rect, &rect)){
+        rect = {0, 0, 0, 0};
+    }
+
+    // add to changed rect
+    if (rect.w && rect.h){
+        if (dirty_rect.w && dirty_rect.h){
+            SDL_UnionRect(&dirty_rect, &rect, &dirty_rect);
+        } else {
+            dirty_rect = rect;
+        }
+    }
+
+    pitch = canvas_width;
+    return pixels.data() + rect.y * canvas_width + rect.x;
+
+}
+
+void REGL_Canvas::unlockPixels(){
+    pixels_mutex.unlock();
+}
+
+void REGL_Canvas::setPixel(int x, int y, REGL_Color color){
+    fill({x, y, 1, 1}, color);
+}
+
+void REGL_Canvas::fill(SDL_Rect rect, REGL_Color color){
+    int pitch;
+    Uint32* rect_pixels = lockPixels(rect, pitch);
+    Uint32 pixel = _packPixel(color);
+    for (int row = 0; row < rect.h; row ++){
+        std::fill(rect_pixels + row * pitch, rect_pixels + row * pitch + rect.w, pixel);
+    }
+    unlockPixels();
+}
+
+void REGL_Canvas::setCells(SDL_Rect rect, const Uint8* values){
+
+    // values are rect.w per row, skip values of clipped rows and columns
+    SDL_Rect clipped_rect = rect;
+    int pitch;
+    Uint32* rect_pixels = lockPixels(clipped_rect, pitch);
+    const Uint8* clipped_values = values + (clipped_rect.y - rect.y) * rect.w + (clipped_rect.x - rect.x);
+    for (int row = 0; row < clipped_rect.h; row ++){
+        Uint32* row_pixels = rect_pixels + row * pitch;
+        const Uint8* row_values = clipped_values + row * rect.w;
+        for (int column = 0; column < clipped_rect.w; column ++){
+            row_pixels[column] = palette[row_values[column]];
+        }
+    }
+    unlockPixels();
+
+}
+
+void REGL_Canvas::setPalette(const std::vector<REGL_Color>& colors){
+    std::lock_guard<std::mutex> lock(pixels_mutex);
+    for (int value = 0; value < 256; value ++){
+        palette[value] = (value < int(colors.size())) ? _packPixel(colors[value]) : 0;
+    }
+}
+
+void REGL_Canvas::setGradient(REGL_Color low_color, REGL_Color high_color){
+    std::vector<REGL_Color> colors(256);
+    for (int value = 0; value < 256; value ++){
+        colors[value] = {
+            Uint8(low_color.r + (high_color.r - low_color.r) * value / 255),
+            Uint8(low_color.g + (high_color.g - low_color.g) * value / 255),
+            Uint8(low_color.b + (high_color.b - low_color.b) * value / 255),
+            Uint8(low_color.a + (high_color.a - low_color.a) * value / 255),
+        };
+    }
+    setPalette(colors);
+}
+
+SDL_Rect REGL_Canvas::bounds(){
+    return {0, 0, width, height};
+}
+
+void REGL_Canvas::render(SDL_Renderer* renderer, int x, int y, REGL_Window* window){
+
+    // create texture and upload everything on first render
+    if (!texture){
+        texture = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_ARGB8888, SDL_TEXTUREACCESS_STREAMING, canvas_width, canvas_height);
+        if (!texture){
+            return;
+        }
+        SDL_SetTextureBlendMode(texture, SDL_BLENDMODE_BLEND);
+        SDL_SetTextureScaleMode(texture, SDL_ScaleModeNearest);
+        std::lock_guard<std::mutex> lock(pixels_mutex);
+        dirty_rect = {0, 0, canvas_width, canvas_height};
+    }
+
+    // upload only the changed rect
+    {
+        std::lock_guard<std::mutex> lock(pixels_mutex);
+        void* texture_pixels;
+        int texture_pitch;
+        if (dirty_rect.w && dirty_rect.h && SDL_LockTexture(texture, &dirty_rect, &texture_pixels, &texture_pitch) == 0){
+            for (int row = 0; row < dirty_rect.h; row ++){
+                memcpy(
+                    (Uint8*) texture_pixels + row * texture_pitch,
+                    pixels.data() + (dirty_rect.y + row) * canvas_width + dirty_rect.x,
+                    dirty_rect.w * sizeof(Uint32)
+                );
+            }
+            SDL_UnlockTexture(texture);
+            dirty_rect = {0, 0, 0, 0};
+        }
+    }
+
+    // crop rect
+    SDL_Rect canvas_rect = {x, y, width, height};
+    SDL_Rect cropped_rect = getIncludeCrop(canvas_rect, window->rect);
+    if (!cropped_rect.w || !cropped_rect.h || !width || !height){
+        return;
+    }
+    SDL_Rect render_rect = {x + cropped_rect.x, y + cropped_rect.y, cropped_rect.w, cropped_rect.h};
+
+    // scale crop rect to canvas pixels
+    cropped_rect.x = cropped_rect.x * canvas_width / width;
+    cropped_rect.y = cropped_rect.y * canvas_height / height;
+    cropped_rect.w = cropped_rect.w * canvas_width / width;
+    cropped_rect.h = cropped_rect.h * canvas_height / height;
+
+    SDL_RenderCopy(renderer, texture, &cropped_rect, &render_rect);
+
+}
+
+// Line index of a log file, built on the thread pool and shared with the log view.
+// Only every checkpoint_lines-th line start is kept, so multi GB files stay small to index.
+class _LogIndex{
+
+    public:
+
+        std::string path; // file path
+        std::shared_ptr<REGL_MappedFile> file; // current mapping, replaced when the file size changes
+        std::vector<Uint64> checkpoints = {0}; // start of every checkpoint_lines-th line
+        Uint64 checkpoint_lines = 64; // lines between checkpoints
+        Uint64 line_count = 1; // number of lines indexed, the last one might not be finished
+        Uint64 last_line_start = 0; // start of the last line indexed
+        Uint64 indexed_bytes = 0; // bytes indexed
+        Uint64 generation = 0; // changed when the file shrinks and is indexed again
+        size_t chunk_size = 16 * 1024 * 1024; // bytes indexed before new lines are shown
+        std::mutex index_mutex; // guards everything above
+        std::atomic<bool> indexing = false; // whether a worker is indexing
+        std::atomic<bool> cancelled = false; // set when the log view is destroyed
+
+        // map the file again if its size changed and index new bytes, run on the thread pool
+        void update();
+
+};
+
+void _LogIndex::update(){
+
+    // get file size without mapping it
+    Uint64 file_size = 0;
+    WIN32_FILE_ATTRIBUTE_DATA attributes;
+    if (GetFileAttributesExA(path.c_str(), GetFileExInfoStandard, &attributes)){
+        file_size = (Uint64(attributes.nFileSizeHigh) << 32) | attributes.nFileSizeLow;
+    }
+
+    // map again if the file grew or shrank, readers keep the old mapping alive
+    std::shared_ptr<REGL_MappedFile> indexed_file;
+    Uint64 indexed;
+    {
+        std::lock_guard<std::mutex> lock(index_mutex);
+        indexed_file = file;
+        indexed = indexed_bytes;
+    }
+    if (!indexed_file || indexed_file->size != file_size){
+        std::shared_ptr<REGL_MappedFile> new_file = std::make_shared<REGL_MappedFile>();
+        if (!file_size || !new_file->open(path)){
+            new_file = NULL;
+        }
+        std::lock_guard<std::mutex> lock(index_mutex);
+        if (!new_file || new_file->size < indexed_bytes){
+            checkpoints = {0};
+            line_count = 1;
+            last_line_start = 0;
+            indexed_bytes = 0;
+            generation += 1;
+        }
+        file = indexed_file = new_file;
+        indexed = indexed_bytes;
+    }
+
+    // index new bytes a chunk at a time
+    while (indexed_file && indexed < indexed_file->size && !cancelled){
+
+        Uint64 chunk_end = regl_min(indexed + chunk_size, Uint64(indexed_file->size));
+        std::vector<Uint64> new_starts;
+        const char* data = indexed_file->data;
+        const char* newline = data + indexed;
+        while ((newline = (const char*) memchr(newline, '\n', data + chunk_end - newline))){
+            newline += 1;
+            new_starts.push_back(newline - data);
+        }
+
+        // publish lines
+        std::lock_guard<std::mutex> lock(index_mutex);
+        for (Uint64 line_start: new_starts){
+            if (line_count % checkpoint_lines == 0){
+                checkpoints.push_back(line_start);
+            }
+            line_count += 1;
+            last_line_start = line_start;
+        }
+        indexed_bytes = indexed = chunk_end;
+
+    }
+
+    indexing = false;
+
+}
+
+// Log view class. Shows a memory mapped text file of any size and follows data appended to it.
+class REGL_LogView : public REGL_ChildObject{
+
+    public:
+
+        int width, height; // dimensions
+        float text_size; // text size
+        REGL_Color text_color; // text color
+        REGL_Color background_color; // background color
+        REGL_Font* font = NULL; // font, default font if NULL
+        std::shared_ptr<_LogIndex> index; // line index, also held by indexing workers
+        Uint64 scroll_line = 0; // first visible line
+        bool follow = true; // whether to keep the last line visible when lines are appended
+        Uint32 poll_interval = 250; // milliseconds between checks for appended data
+        Uint32 last_poll = 0; // ticks when the file was last checked
+        size_t max_line_length = 1024; // bytes of a line shown
+        std::unordered_map<Uint64, _CachedCell> line_cache; // placed lines by line number
+        size_t line_cache_size = 4096; // number of lines kept before the cache is cleared
+        Uint64 cached_generation = 0; // index generation the cached lines are from
+
+        // custom render function
+        void render(SDL_Renderer* renderer, int x, int y, REGL_Window* window) override;
+
+        // custom bounds function
+        SDL_Rect bounds() override;
+
+        // custom layout function
+        void layout(REGL_Window* window) override;
+
+        // custom scrolled function
+        void scrolled(SDL_Rect mouse_rect, int scrolled) override;
+        bool consumesScroll(SDL_Rect mouse_rect, int scrolled) override;
+
+        // custom collision function
+        bool collides(SDL_Rect other_rect, int x, int y) override;
+
+        // get line height
+        int lineHeight();
+
+        // get number of lines, without the empty line after a final newline
+        Uint64 lineCount();
+
+        // get the scroll line that shows the last line at the bottom
+        Uint64 lastScrollLine();
+
+        // show another file
+        void open(std::string path);
+
+        // constructor
+        REGL_LogView(
+            std::string path,
+            int width, int height,
+            float text_size, REGL_Color text_color, REGL_Color background_color,
+            int nextline, int indent
+        );
+
+        // destructor
+        ~REGL_LogView();
+
+};
+
+REGL_LogView::REGL_LogView(
+    std::string path,
+    int width, int height,
+    float text_size, REGL_Color text_color, REGL_Color background_color,
+    int nextline, int indent
+) : REGL_ChildObject(nextline, indent){
+
+    this->width = width;
+    this->height = height;
+    this->text_size = text_size;
+    this->text_color = text_color;
+    this->background_color = background_color;
+    open(path);
+
+    if (nextline == REGL_NEXTLINE_DEFAULT){
+        decided_nextline = height + 10;
+    }
+
+}
+
+REGL_LogView::~REGL_LogView(){
+    index->cancelled = true;
+}
+
+void REGL_LogView::open(std::string path){
+
+    // stop indexing the old file, the worker keeps its index alive
+    if (index){
+        index->cancelled = true;
+    }
+    index = std::make_shared<_LogIndex>();
+    index->path = path;
+    line_cache.clear();
+    scroll_line = 0;
+    follow = true;
+
+    // start indexing
+    index->indexing = true;
+    std::shared_ptr<_LogIndex> started_index = index;
+    reglThreadPool().submit([started_index]{started_index->update();});
+    last_poll = SDL_GetTicks();
+
+}
+
+int REGL_LogView::lineHeight(){
+    return regl_max(int(textHeight("A", text_size, font)), 1);
+}
+
+Uint64 REGL_LogView::lineCount(){
+    std::lock_guard<std::mutex> lock(index->index_mutex);
+    bool empty_last_line = index->line_count > 1 && index->last_line_start == index->indexed_bytes;
+    return index->line_count - empty_last_line;
+}
+
+Uint64 REGL_LogView::lastScrollLine(){
+    Uint64 visible_lines = height / lineHeight();
+    Uint64 line_count = lineCount();
+    return (line_count > visible_lines) ? line_count - visible_lines : 0;
+}
+
+void REGL_LogView::scrolled(SDL_Rect mouse_rect, int scrolled){
+    Uint64 last_scroll_line = lastScrollLine();
+    scroll_line = regl_min(Uint64(regl_max(Sint64(scroll_line) + scrolled * 3, Sint64(0))), last_scroll_line);
+    follow = scroll_line == last_scroll_line;
+}
+bool REGL_LogView::consumesScroll(SDL_Rect mouse_rect, int scrolled){
+    return (scrolled < 0) ? scroll_line > 0 : scroll_line < lastScrollLine();
+}
+
+bool REGL_LogView::collides(SDL_Rect other_rect, int x, int y){
+    SDL_Rect collision_rect = {x, y, width, height};
+    return SDL_HasIntersection(&collision_rect, &other_rect);
+}
+
+void REGL_LogView::layout(REGL_Window* window){
+    decided_nextline = height + 10;
+}
+
+SDL_Rect REGL_LogView::bounds(){
+    return {0, 0, width, height};
+}
+
+void REGL_LogView::render(SDL_Renderer* renderer, int x, int y, REGL_Window* window){
+
+    // check for appended data in the background
+    if (!index->indexing && SDL_GetTicks() - last_poll >= poll_interval){
+        index->indexing = true;
+        std::shared_ptr<_LogIndex> polled_index = index;
+        reglThreadPool().submit([polled_index]{polled_index->update();});
+        last_poll = SDL_GetTicks();
+    }
+
+    // draw background
+    SDL_SetRenderDrawColor(renderer, background_color.r, background_color.g, background_color.b, background_color.a);
+    SDL_FillIncludeRect(renderer, {x, y, width, height}, window->rect);
+
+    // crop text to the log view and the window
+    SDL_Rect view_rect = {x, y, width, height};
+    SDL_Rect include_rect;
+    if (!SDL_IntersectRect(&view_rect, &window->rect, &include_rect)){
+        return;
+    }
+
+    // keep last line visible when following
+    int line_height = lineHeight();
+    Uint64 visible_lines = height / line_height + 1;
+    Uint64 line_count = lineCount();
+    Uint64 last_scroll_line = lastScrollLine();
+    if (follow || scroll_line > last_scroll_line){
+        scroll_line = last_scroll_line;
+    }
+
+    // get mapping and the checkpoint before the first visible line
+    std::shared_ptr<REGL_MappedFile> file;
+    Uint64 line_start, checkpoint_line, indexed_bytes;
+    {
+        std::lock_guard<std::mutex> lock(index->index_mutex);
+        file = index->file;
+        indexed_bytes = index->indexed_bytes;
+        checkpoint_line = scroll_line / index->checkpoint_lines;
+        line_start = index->checkpoints[regl_min(size_t(checkpoint_line), index->checkpoints.size() - 1)];
+        checkpoint_line *= index->checkpoint_lines;
+
+        // drop lines of a file that shrank
+        if (cached_generation != index->generation){
+            cached_generation = index->generation;
+            line_cache.clear();
+        }
+    }
+    if (!file){
+        return;
+    }
+
+    // find first visible line from the checkpoint
+    const char* data = file->data;
+    for (; checkpoint_line < scroll_line && line_start < indexed_bytes; checkpoint_line ++){
+        const char* newline = (const char*) memchr(data + line_start, '\n', indexed_bytes - line_start);
+        line_start = (newline) ? newline - data + 1 : indexed_bytes;
+    }
+
+    // keep cache bounded
+    if (line_cache.size() >= line_cache_size){
+        line_cache.clear();
+    }
+
+    // only visible lines are placed and drawn
+    float available_width = width / text_size;
+    for (Uint64 line = scroll_line; line < scroll_line + visible_lines && line < line_count; line ++){
+
+        const char* newline = (const char*) memchr(data + line_start, '\n', indexed_bytes - line_start);
+        Uint64 line_end = (newline) ? newline - data : indexed_bytes;
+
+        // the last line might still be appended to, so it isn't cached
+        _CachedCell unfinished_line;
+        bool cached = newline && line_cache.count(line);
+        _CachedCell& placed_line = (newline) ? line_cache[line] : unfinished_line;
+        if (!cached){
+
+            // cut long lines and carriage returns
+            Uint64 shown_end = regl_min(line_end, line_start + max_line_length);
+            if (shown_end > line_start && shown_end == line_end && data[shown_end - 1] == '\r'){
+                shown_end -= 1;
+            }
+            placed_line.text.assign(data + line_start, shown_end - line_start);
+            placeText(placed_line.text, placed_line.offsets, font);
+
+            // cut characters past the right edge
+            size_t kept = std::upper_bound(placed_line.offsets.begin(), placed_line.offsets.end(), available_width) - placed_line.offsets.begin();
+            if (kept < placed_line.offsets.size()){
+                placed_line.text.resize(regl_max(int(kept) - 1, 0));
+                placed_line.offsets.resize(placed_line.text.size() + 1);
+            }
+
+        }
+
+        renderPlacedText(
+            renderer, text_color, placed_line.text, placed_line.offsets,
+            x, int(y + (line - scroll_line) * line_height), text_size, include_rect, font
+        );
+        line_start = line_end + 1;
+
+    }
+
+}
+
+// Place a percentage label, only if the percentage changed since it was last placed.
+void _placePercent(float value, int& placed_percent, _CachedCell& percent_text, REGL_Font* font){
+    int percent = int(regl_min(regl_max(value, 0.0f), 1.0f) * 100 + 0.5f);
+    if (percent != placed_percent){
+        placed_percent = percent;
+        percent_text.text = std::to_string(percent) + "%";
+        placeText(percent_text.text, percent_text.offsets, font);
+    }
+}
+
+// Progress bar class. The value can be set from any thread without allocating or laying out again.
+class REGL_ProgressBar : public REGL_ChildObject{
+
+    public:
+
+        int width, height; // dimensions
+        int edge_radius; // radius of the rounded edges
+        REGL_Color track_color; // color of the unfilled part
+        REGL_Color fill_color; // color of the filled part
+        std::atomic<float> value = 0; // filled fraction from 0 to 1
+        bool show_percent = false; // whether to draw the percentage in the middle
+        float text_size = 0.3f; // percentage text size
+        REGL_Color text_color = REGL_COLOR_WHITE; // percentage text color
+        REGL_Font* font = NULL; // font, default font if NULL
+        int placed_percent = -1; // percentage of percent_text
+        _CachedCell percent_text; // placed percentage
+
+        // custom render function
+        void render(SDL_Renderer* renderer, int x, int y, REGL_Window* window) override;
+
+        // custom bounds function
+        SDL_Rect bounds() override;
+
+        // set value, can be called from any thread
+        void setValue(float new_value);
+
+        // constructor
+        REGL_ProgressBar(
+            int width, int height, int edge_radius,
+            REGL_Color track_color, REGL_Color fill_color,
+            int nextline, int indent
+        );
+
+};
+
+REGL_ProgressBar::REGL_ProgressBar(
+    int width, int height, int edge_radius,
+    REGL_Color track_color, REGL_Color fill_color,
+    int nextline, int indent
+) : REGL_ChildObject(nextline, indent){
+
+    this->width = width;
+    this->height = height;
+    this->edge_radius = regl_min(edge_radius, height / 2);
+    this->track_color = track_color;
+    this->fill_color = fill_color;
+
+    if (nextline == REGL_NEXTLINE_DEFAULT){
+        decided_nextline = height + 10;
+    }
+
+}
+
+void REGL_ProgressBar::setValue(float new_value){
+    value.store(regl_min(regl_max(new_value, 0.0f), 1.0f), std::memory_order_relaxed);
+}
+
+SDL_Rect REGL_ProgressBar::bounds(){
+    return {0, 0, width, height};
+}
+
+void REGL_ProgressBar::render(SDL_Renderer* renderer, int x, int y, REGL_Window* window){
+
+    float current_value = value.load(std::memory_order_relaxed);
+
+    // draw track
+    SDL_Rect bar_rect = {x, y, width, height};
+    drawRoundedRect(renderer, bar_rect, edge_radius, track_color, window->rect);
+
+    // draw the same shape again cropped to the filled part, so only the fill extent depends on the value
+    SDL_Rect fill_rect = {x, y, int(width * current_value + 0.5f), height};
+    SDL_Rect fill_include_rect;
+    if (fill_rect.w && SDL_IntersectRect(&fill_rect, &window->rect, &fill_include_rect)){
+        drawRoundedRect(renderer, bar_rect, edge_radius, fill_color, fill_include_rect);
+    }
+
+    // draw percentage, only placed again when it changes
+    if (show_percent){
+        _placePercent(current_value, placed_percent, percent_text, font);
+        renderPlacedText(
+            renderer, text_color, percent_text.text, percent_text.offsets,
+            int(x + (width - percent_text.offsets.back() * text_size) / 2),
+            int(y + (height - textHeight("A", text_size, font)) / 2),
+            text_size, window->rect, font
+        );
+    }
+
+}
+
+// Gauge class. Draws a value as an arc from precomputed points, the value can be set from any thread.
+class REGL_Gauge : public REGL_ChildObject{
+
+    public:
+
+        int radius; // outer radius
+        int thickness; // arc thickness
+        REGL_Color track_color; // color of the unfilled arc
+        REGL_Color fill_color; // color of the filled arc
+        std::atomic<float> value = 0; // filled fraction from 0 to 1
+        bool show_percent = true; // whether to draw the percentage in the middle
+        float text_size = 0.4f; // percentage text size
+        REGL_Color text_color = REGL_COLOR_WHITE; // percentage text color
+        REGL_Font* font = NULL; // font, default font if NULL
+        int placed_percent = -1; // percentage of percent_text
+        _CachedCell percent_text; // placed percentage
+        int segments = 180; // number of arc segments
+        std::vector<SDL_FPoint> arc_points; // inner and outer point of each segment edge, relative to the center
+        std::vector<int> arc_indices; // two triangles per segment
+        std::vector<SDL_Vertex> track_vertices, fill_vertices; // arc points moved to the render position
+        int vertices_x = 0, vertices_y = 0; // render position of the vertices
+        Uint32 vertices_track_color = 0, vertices_fill_color = 0; // packed colors of the vertices
+        bool vertices_placed = false; // whether the vertices were moved at least once
+
+        // custom render function
+        void render(SDL_Renderer* renderer, int x, int y, REGL_Window* window) override;
+
+        // custom bounds function
+        SDL_Rect bounds() override;
+
+        // set value, can be called from any thread
+        void setValue(float new_value);
+
+        // constructor
+        REGL_Gauge(
+            int radius, int thickness,
+            REGL_Color track_color, REGL_Color fill_color,
+            int nextline, int indent
+        );
+
+};
+
+REGL_Gauge::REGL_Gauge(
+    int radius, int thickness,
+    REGL_Color track_color, REGL_Color fill_color,
+    int nextline, int indent
+) : REGL_ChildObject(nextline, indent){
+
+    this->radius = radius;
+    this->thickness = regl_min(thickness, radius);
+    this->track_color = track_color;
+    this->fill_color = fill_color;
+
+    // arc from the bottom left to the bottom right, going over the top
+    float start_angle = M_PI * 0.75f, sweep_angle = M_PI * 1.5f;
+    for (int edge = 0; edge <= segments; edge ++){
+        float angle = start_angle + sweep_angle * edge / segments;
+        arc_points.push_back({std::cos(angle) * (radius - this->thickness), std::sin(angle) * (radius - this->thickness)});
+        arc_points.push_back({std::cos(angle) * radius, std::sin(angle) * radius});
+    }
+    for (int segment = 0; segment < segments; segment ++){
+        int first = segment * 2;
+        arc_indices.insert(arc_indices.end(), {first, first + 1, first + 3, first, first + 3, first + 2});
+    }
+
+    if (nextline == REGL_NEXTLINE_DEFAULT){
+        decided_nextline = radius * 2 + 10;
+    }
+
+}
+
+void REGL_Gauge::setValue(float new_value){
+    value.store(regl_min(regl_max(new_value, 0.0f), 1.0f), std::memory_order_relaxed);
+}
+
+SDL_Rect REGL_Gauge::bounds(){
+    return {0, 0, radius * 2, radius * 2};
+}
+
+void REGL_Gauge::render(SDL_Renderer* renderer, int x, int y, REGL_Window* window){
+
+    float current_value = value.load(std::memory_order_relaxed);
+
+    // only move vertices when the gauge moved or its colors changed
+    Uint32 packed_track_color = _packPixel(track_color);
+    Uint32 packed_fill_color = _packPixel(fill_color);
+    bool colors_changed = packed_track_color != vertices_track_color || packed_fill_color != vertices_fill_color;
+    if (!vertices_placed || x != vertices_x || y != vertices_y || colors_changed){
+        track_vertices.resize(arc_points.size());
+        fill_vertices.resize(arc_points.size());
+        SDL_Color track_vertex_color = {Uint8(track_color.r), Uint8(track_color.g), Uint8(track_color.b), Uint8(track_color.a)};
+        SDL_Color fill_vertex_color = {Uint8(fill_color.r), Uint8(fill_color.g), Uint8(fill_color.b), Uint8(fill_color.a)};
+        for (size_t index = 0; index < arc_points.size(); index ++){
+            SDL_FPoint position = {x + radius + arc_points[index].x, y + radius + arc_points[index].y};
+            track_vertices[index] = {position, track_vertex_color, {0, 0}};
+            fill_vertices[index] = {position, fill_vertex_color, {0, 0}};
+        }
+        vertices_x = x;
+        vertices_y = y;
+        vertices_track_color = packed_track_color;
+        vertices_fill_color = packed_fill_color;
+        vertices_placed = true;
+    }
+
+    // clip to the window
+    SDL_Rect gauge_rect = {x, y, radius * 2, radius * 2};
+    SDL_Rect clip_rect;
+    if (!SDL_IntersectRect(&gauge_rect, &window->rect, &clip_rect)){
+        return;
+    }
+    SDL_RenderSetClipRect(renderer, &clip_rect);
+
+    // draw track, then the filled segments over it
+    int filled_segments = int(current_value * segments + 0.5f);
+    SDL_RenderGeometry(renderer, NULL, track_vertices.data(), track_vertices.size(), arc_indices.data(), arc_indices.size());
+    if (filled_segments){
+        SDL_RenderGeometry(renderer, NULL, fill_vertices.data(), fill_vertices.size(), arc_indices.data(), filled_segments * 6);
+    }
+    SDL_RenderSetClipRect(renderer, NULL);
+
+    // draw percentage, only placed again when it changes
+    if (show_percent){
+        _placePercent(current_value, placed_percent, percent_text, font);
+        renderPlacedText(
+            renderer, text_color, percent_text.text, percent_text.offsets,
+            int(x + radius - percent_text.offsets.back() * text_size / 2),
+            int(y + radius - textHeight("A", text_size, font) / 2),
+            text_size, window->rect, font
+        );
+    }
+
+}
+
+// Slider class. Dragging follows the mouse outside the slider, and on_change is called at most once per frame.
+class REGL_Slider : public REGL_ChildObject{
+
+    public:
+
+        int width, height; // dimensions, the thumb is as big as the height
+        float min_value, max_value; // value range
+        float step; // values are rounded to steps from min_value, 0 for no rounding
+        float value; // current value
+        float reported_value; // value on_change was last called with
+        REGL_Color track_color; // color of the track right of the thumb
+        REGL_Color fill_color; // color of the track left of the thumb
+        REGL_Color thumb_color; // color of the thumb
+        std::function<void(float)> on_change; // called with the new value at most once per frame
+        std::function<void(float)> on_release = NULL; // called with the value when a drag ends
+        bool dragging = false; // whether the thumb is being dragged
+        int last_x = 0, last_y = 0; // last position
+
+        // custom render function
+        void render(SDL_Renderer* renderer, int x, int y, REGL_Window* window) override;
+
+        // custom bounds function
+        SDL_Rect bounds() override;
+
+        // custom clicked function
+        void clicked(SDL_Rect mouse_rect) override;
+
+        // custom hovered function
+        void hovered(SDL_Rect mouse_rect) override;
+
+        // custom input function, arrow keys move by one step
+        void input(const REGL_Event& event) override;
+
+        // custom collision function
+        bool collides(SDL_Rect other_rect, int x, int y) override;
+
+        // set value, clamped and rounded to a step, on_change is called on the next frame
+        void setValue(float new_value);
+
+        // get value at a mouse x position
+        float valueAt(int mouse_x);
+
+        // constructor
+        REGL_Slider(
+            float min_value, float max_value, float initial_value, float step,
+            int width, int height,
+            REGL_Color track_color, REGL_Color fill_color, REGL_Color thumb_color,
+            std::function<void(float)> on_change,
+            int nextline, int indent
+        );
+
+};
+
+REGL_Slider::REGL_Slider(
+    float min_value, float max_value, float initial_value, float step,
+    int width, int height,
+    REGL_Color track_color, REGL_Color fill_color, REGL_Color thumb_color,
+    std::function<void(float)> on_change,
+    int nextline, int indent
+) : REGL_ChildObject(nextline, indent){
+
+    this->min_value = min_value;
+    this->max_value = regl_max(max_value, min_value);
+    this->step = step;
+    this->width = regl_max(width, height);
+    this->height = height;
+    this->track_color = track_color;
+    this->fill_color = fill_color;
+    this->thumb_color = thumb_color;
+    this->on_change = on_change;
+    setValue(initial_value);
+    reported_value = value;
+
+    if (nextline == REGL_NEXTLINE_DEFAULT){
+        decided_nextline = height + 10;
+    }
+
+}
+
+void REGL_Slider::setValue(float new_value){
+    if (step > 0){
+        new_value = min_value + std::round((new_value - min_value) / step) * step;
+    }
+    value = regl_min(regl_max(new_value, min_value), max_value);
+}
+
+float REGL_Slider::valueAt(int mouse_x){
+    // the thumb center moves between half a thumb from each end
+    float fraction = float(mouse_x - last_x - height / 2) / regl_max(width - height, 1);
+    return min_value + regl_min(regl_max(fraction, 0.0f), 1.0f) * (max_value - min_value);
+}
+
+void REGL_Slider::clicked(SDL_Rect mouse_rect){
+    setValue(valueAt(mouse_rect.x));
+    dragging = true;
+}
+
+void REGL_Slider::hovered(SDL_Rect mouse_rect){
+    requested_cursor = REGL_CURSOR_CLICKABLE; // set cursor to clickable
+}
+
+void REGL_Slider::input(const REGL_Event& event){
+    if (event.type != REGL_EVENT_KEY_DOWN){
+        return;
+    }
+    float key_step = (step > 0) ? step : (max_value - min_value) / 100;
+    if (event.key == SDLK_LEFT){
+        setValue(value - key_step);
+    } else if (event.key == SDLK_RIGHT){
+        setValue(value + key_step);
+    }
+}
+
+bool REGL_Slider::collides(SDL_Rect other_rect, int x, int y){
+    last_x = x;
+    last_y = y;
+    SDL_Rect collision_rect = {x, y, width, height};
+    return SDL_HasIntersection(&collision_rect, &other_rect);
+}
+
+SDL_Rect REGL_Slider::bounds(){
+    return {0, 0, width, height};
+}
+
+void REGL_Slider::render(SDL_Renderer* renderer, int x, int y, REGL_Window* window){
+
+    last_x = x;
+    last_y = y;
+
+    // follow the mouse anywhere while dragging, like dragging windows
+    bool released = false;
+    if (dragging){
+        setValue(valueAt(mouse_rect.x));
+        if (!mouse_held && !mouse_clicked){
+            dragging = false;
+            released = true;
+        }
+    }
+
+    // report the value once per frame, however many times it changed
+    if (value != reported_value){
+        reported_value = value;
+        if (on_change){
+            on_change(value);
+        }
+    }
+    if (released && on_release){
+        on_release(value);
+    }
+
+    // draw track, the part left of the thumb in the fill color
+    int track_height = regl_max(height / 3, 2);
+    SDL_Rect track_rect = {x, y + (height - track_height) / 2, width, track_height};
+    float fraction = (max_value > min_value) ? (value - min_value) / (max_value - min_value) : 0;
+    int thumb_x = x + int(fraction * (width - height) + 0.5f);
+    drawRoundedRect(renderer, track_rect, track_height / 2, track_color, window->rect);
+    SDL_Rect fill_rect = {x, y, thumb_x + height / 2 - x, height};
+    SDL_Rect fill_include_rect;
+    if (SDL_IntersectRect(&fill_rect, &window->rect, &fill_include_rect)){
+        drawRoundedRect(renderer, track_rect, track_height / 2, fill_color, fill_include_rect);
+    }
+
+    // draw thumb
+    drawRoundedRect(renderer, {thumb_x, y, height, height}, height / 2, thumb_color, window->rect);
+
+}
+
+// Popup of a dropdown, in the overlay layer while open.
+class _DropdownPopup : public REGL_Object{
+
+    public:
+
+        REGL_Dropdown* dropdown; // dropdown this popup belongs to
+
+        // forwarded to the dropdown
+        void render(SDL_Renderer* renderer) override;
+        void update() override{};
+        void clicked(SDL_Rect mouse_rect) override;
+        void hovered(SDL_Rect mouse_rect) override;
+        void scrolled(SDL_Rect mouse_rect, int scrolled) override;
+        void input(const REGL_Event& event) override;
+        bool collides(SDL_Rect other_rect) override;
+
+};
+
+// Dropdown class. Picks one of many options, filtered as the user types.
+// Only the visible options of the popup are drawn, and the popup is drawn above all windows.
+class REGL_Dropdown : public REGL_ChildObject{
+
+    public:
+
+        std::vector<std::string> options; // option labels
+        REGL_OptionIndex option_index; // prefix and trigram index of the labels
+        const std::vector<int>* matches; // options matching the query
+        std::string query; // typed filter
+        int selected = -1; // selected option, -1 if none
+        int highlighted = 0; // highlighted match
+        int scroll_row = 0; // first visible match
+        int width, row_height; // dimensions of the dropdown and each option
+        int visible_rows; // maximum number of options shown at once
+        float text_size; // text size
+        REGL_Color text_color; // text color
+        REGL_Color background_color; // background color
+        REGL_Color highlight_color; // color of the highlighted option
+        REGL_Font* font = NULL; // font, default font if NULL
+        std::function<void(int)> on_select; // called with the selected option
+        std::string placeholder = "Select..."; // shown when nothing is selected
+        bool open = false; // whether the popup is open
+        bool rendered = false; // whether the dropdown was rendered since the popup was last rendered
+        _DropdownPopup popup; // popup in the overlay layer
+        SDL_Rect popup_rect = {0, 0, 0, 0}; // popup position
+        REGL_Window* parent_window = NULL; // window the dropdown was last rendered in
+        int last_x = 0, last_y = 0; // last position
+
+        // custom render function
+        void render(SDL_Renderer* renderer, int x, int y, REGL_Window* window) override;
+
+        // custom bounds function
+        SDL_Rect bounds() override;
+
+        // custom clicked function
+        void clicked(SDL_Rect mouse_rect) override;
+
+        // custom hovered function
+        void hovered(SDL_Rect mouse_rect) override;
+
+        // custom input function, typing filters options
+        void input(const REGL_Event& event) override;
+
+        // custom collision function
+        bool collides(SDL_Rect other_rect, int x, int y) override;
+
+        // change options, clears the selection
+        void setOptions(std::vector<std::string> new_options);
+
+        // open or close the popup
+        void openPopup();
+        void closePopup();
+
+        // select an option and close the popup
+        void select(int option);
+
+        // filter options by the query again
+        void refilter();
+
+        // scroll so the highlighted match is visible
+        void keepHighlightedVisible();
+
+        // popup events
+        void renderPopup(SDL_Renderer* renderer);
+        int rowAt(SDL_Rect mouse_rect);
+
+        // constructor
+        REGL_Dropdown(
+            std::vector<std::string> options,
+            std::function<void(int)> on_select,
+            int width, int row_height, int visible_rows,
+            float text_size, REGL_Color text_color, REGL_Color background_color, REGL_Color highlight_color,
+            int nextline, int indent
+        );
+
+        // destructor
+        ~REGL_Dropdown();
+
+};
+
+REGL_Dropdown::REGL_Dropdown(
+    std::vector<std::string> options,
+    std::function<void(int)> on_select,
+    int width, int row_height, int visible_rows,
+    float text_size, REGL_Color text_color, REGL_Color background_color, REGL_Color highlight_color,
+    int nextline, int indent
+) : REGL_ChildObject(nextline, indent){
+
+    this->on_select = on_select;
+    this->width = width;
+    this->row_height = row_height;
+    this->visible_rows = regl_max(visible_rows, 1);
+    this->text_size = text_size;
+    this->text_color = text_color;
+    this->background_color = background_color;
+    this->highlight_color = highlight_color;
+    popup.dropdown = this;
+    popup.enabled = false;
+    setOptions(options);
+
+    if (nextline == REGL_NEXTLINE_DEFAULT){
+        decided_nextline = row_height + 10;
+    }
+
+}
+
+REGL_Dropdown::~REGL_Dropdown(){
+    // don't leave the popup in the overlay layer
+    regl_overlays.erase(std::remove(regl_overlays.begin(), regl_overlays.end(), &popup), regl_overlays.end());
+    if (focused_object == &popup){
+        focused_object = NULL;
+    }
+}
+
+void REGL_Dropdown::setOptions(std::vector<std::string> new_options){
+    options = std::move(new_options);
+    option_index.build(options);
+    selected = -1;
+    refilter();
+}
+
+void REGL_Dropdown::refilter(){
+    matches = &option_index.filter(query);
+    highlighted = 0;
+    scroll_row = 0;
+}
+
+void REGL_Dropdown::keepHighlightedVisible(){
+    if (highlighted < scroll_row){
+        scroll_row = highlighted;
+    } else if (highlighted >= scroll_row + visible_rows){
+        scroll_row = highlighted - visible_rows + 1;
+    }
+}
+
+void REGL_Dropdown::openPopup(){
+
+    open = true;
+    query.clear();
+    refilter();
+
+    // start at the selected option, matches are all options in order for an empty query
+    if (selected != -1){
+        highlighted = selected;
+        keepHighlightedVisible();
+    }
+
+    // added to the overlay layer once, closed popups are removed after rendering
+    popup.enabled = true;
+    if (std::find(regl_overlays.begin(), regl_overlays.end(), &popup) == regl_overlays.end()){
+        regl_overlays.push_back(&popup);
+    }
+
+}
+
+void REGL_Dropdown::closePopup(){
+    open = false;
+    popup.enabled = false;
+    query.clear();
+    if (focused_object == &popup){
+        focused_object = parent_window;
+    }
+}
+
+void REGL_Dropdown::select(int option){
+    selected = option;
+    closePopup();
+    if (on_select){
+        on_select(option);
+    }
+}
+
+void REGL_Dropdown::clicked(SDL_Rect mouse_rect){
+    if (open){
+        closePopup();
+    } else {
+        openPopup();
+    }
+}
+
+void REGL_Dropdown::hovered(SDL_Rect mouse_rect){
+    requested_cursor = REGL_CURSOR_CLICKABLE; // set cursor to clickable
+}
+
+void REGL_Dropdown::input(const REGL_Event& event){
+
+    // typing opens the popup
+    if (!open){
+        if (event.type == REGL_EVENT_TEXT_INPUT || event.key == SDLK_DOWN || event.key == SDLK_RETURN){
+            openPopup();
+        }
+        if (event.type != REGL_EVENT_TEXT_INPUT){
+            return;
+        }
+    }
+
+    // filter by typed text, only the last matches are checked while the query grows
+    if (event.type == REGL_EVENT_TEXT_INPUT){
+        query += event.text;
+        refilter();
+        return;
+    }
+
+    int match_count = matches->size();
+    if (event.key == SDLK_BACKSPACE && !query.empty()){
+
+        // remove last utf-8 character
+        size_t last_character = query.size() - 1;
+        while (last_character && (query[last_character] & 0xC0) == 0x80){
+            last_character -= 1;
+        }
+        query.erase(last_character);
+        refilter();
+
+    } else if (event.key == SDLK_UP && match_count){
+        highlighted = regl_max(highlighted - 1, 0);
+        keepHighlightedVisible();
+    } else if (event.key == SDLK_DOWN && match_count){
+        highlighted = regl_min(highlighted + 1, match_count - 1);
+        keepHighlightedVisible();
+    } else if ((event.key == SDLK_RETURN || event.key == SDLK_KP_ENTER) && highlighted < match_count){
+        select((*matches)[highlighted]);
+    } else if (event.key == SDLK_ESCAPE){
+        closePopup();
+    }
+
+}
+
+bool REGL_Dropdown::collides(SDL_Rect other_rect, int x, int y){
+    last_x = x;
+    last_y = y;
+    SDL_Rect collision_rect = {x, y, width, row_height};
+    return SDL_HasIntersection(&collision_rect, &other_rect);
+}
+
+SDL_Rect REGL_Dropdown::bounds(){
+    return {0, 0, width, row_height};
+}
+
+void REGL_Dropdown::render(SDL_Renderer* renderer, int x, int y, REGL_Window* window){
+
+    last_x = x;
+    last_y = y;
+    parent_window = window;
+    rendered = true;
+
+    // close when something else was clicked
+    if (open && focused_object != &popup && !(focused_object == window && window->focused_child == this)){
+        closePopup();
+    }
+
+    // draw box
+    SDL_Rect box_rect = {x, y, width, row_height};
+    SDL_SetRenderDrawColor(renderer, background_color.r, background_color.g, background_color.b, background_color.a);
+    SDL_FillIncludeRect(renderer, box_rect, window->rect);
+    SDL_Rect include_rect;
+    if (!SDL_IntersectRect(&box_rect, &window->rect, &include_rect)){
+        include_rect = {0, 0, 0, 0};
+    }
+
+    // draw query while open, otherwise the selected option
+    int text_y = int(y + (row_height - textHeight("A", text_size, font)) / 2);
+    int arrow_width = int(textHeight("A", text_size, font));
+    include_rect.w = regl_max(regl_min(include_rect.w, x + width - arrow_width - include_rect.x), 0);
+    if (open){
+        renderText(renderer, text_color, query + "|", x + 4, text_y, text_size, 10000, include_rect, font);
+    } else {
+        std::string shown = (selected != -1) ? options[selected] : placeholder;
+        renderText(renderer, text_color, shown, x + 4, text_y, text_size, 10000, include_rect, font);
+    }
+    renderText(renderer, text_color, open ? "^" : "v", x + width - arrow_width, text_y, text_size, 10000, window->rect, font);
+
+    // popup goes below the box, drawn later in the overlay layer
+    int shown_rows = regl_min(visible_rows, int(matches->size()));
+    popup_rect = {x, y + row_height, width, shown_rows * row_height};
+
+}
+
+void REGL_Dropdown::renderPopup(SDL_Renderer* renderer){
+
+    // close if the dropdown wasn't drawn this frame, like when its window was hidden
+    if (!rendered){
+        closePopup();
+        return;
+    }
+    rendered = false;
+    if (!popup_rect.h){
+        return;
+    }
+
+    // draw background and outline
+    SDL_SetRenderDrawColor(renderer, background_color.r, background_color.g, background_color.b, background_color.a);
+    SDL_RenderFillRect(renderer, &popup_rect);
+    SDL_SetRenderDrawColor(renderer, highlight_color.r, highlight_color.g, highlight_color.b, highlight_color.a);
+    SDL_RenderDrawRect(renderer, &popup_rect);
+
+    // only visible options are drawn
+    int last_row = regl_min(scroll_row + visible_rows, int(matches->size()));
+    for (int row = scroll_row; row < last_row; row ++){
+        SDL_Rect row_rect = {popup_rect.x, popup_rect.y + (row - scroll_row) * row_height, popup_rect.w, row_height};
+        if (row == highlighted){
+            SDL_SetRenderDrawColor(renderer, highlight_color.r, highlight_color.g, highlight_color.b, highlight_color.a);
+            SDL_RenderFillRect(renderer, &row_rect);
+        }
+        renderText(
+            renderer, text_color, options[(*matches)[row]],
+            row_rect.x + 4, int(row_rect.y + (row_height - textHeight("A", text_size, font)) / 2),
+            text_size, 10000, row_rect, font
+        );
+    }
+
+}
+
+int REGL_Dropdown::rowAt(SDL_Rect mouse_rect){
+    int row = scroll_row + (mouse_rect.y - popup_rect.y) / row_height;
+    return (row >= 0 && row < int(matches->size())) ? row : -1;
+}
+
+void _DropdownPopup::render(SDL_Renderer* renderer){
+    dropdown->renderPopup(renderer);
+}
+
+void _DropdownPopup::clicked(SDL_Rect mouse_rect){
+    int row = dropdown->rowAt(mouse_rect);
+    if (row != -1){
+        dropdown->select((*dropdown->matches)[row]);
+    }
+}
+
+void _DropdownPopup::hovered(SDL_Rect mouse_rect){
+    int row = dropdown->rowAt(mouse_rect);
+    if (row != -1){
+        dropdown->highlighted = row;
+    }
+    requested_cursor = REGL_CURSOR_CLICKABLE; // set cursor to clickable
+}
+
+void _DropdownPopup::scrolled(SDL_Rect mouse_rect, int scrolled){
+    int last_scroll_row = regl_max(int(dropdown->matches->size()) - dropdown->visible_rows, 0);
+    dropdown->scroll_row = regl_min(regl_max(dropdown->scroll_row + scrolled, 0), last_scroll_row);
+}
+
+void _DropdownPopup::input(const REGL_Event& event){
+    dropdown->input(event);
+}
+
+bool _DropdownPopup::collides(SDL_Rect other_rect){
+    return SDL_HasIntersection(&dropdown->popup_rect, &other_rect);
 }
\ No newline at end of file
@@ -0,0 +1,100 @@
+#include <iostream>
+#include <vector>
+#include <functional>
+#include <utility>
+#include <algorithm>
+
+#pragma once
+
+// Observable value. Subscribers are called only when the value actually changes.
+// Use it on the thread calling reglUpdate, or change it through reglPost.
+template <typename T>
+class REGL_Observable{
+
+    public:
+
+        T value; // current value
+        std::vector<std::pair<int, std::function<void(const T&)>>> subscribers; // subscription ids and functions, id -1 if removed while notifying
+        std::vector<std::pair<int, std::function<void(const T&)>>> added_subscribers; // subscriptions made while notifying
+        int next_id = 0; // id of the next subscription
+        int notifying = 0; // number of set calls notifying subscribers, more than one if a subscriber sets the value
+
+        // get value
+        const T& get(){return value;};
+
+        // set value and notify subscribers if it changed
+        void set(const T& new_value);
+
+        // call a function when the value changes, returns the subscription id
+        int subscribe(std::function<void(const T&)> on_change);
+
+        // remove a subscription
+        void unsubscribe(int id);
+
+        // constructor
+        REGL_Observable(T value = T()) : value(value){};
+
+        // subscribers refer to this, so it can't be copied
+        REGL_Observable(const REGL_Observable&) = delete;
+        REGL_Observable& operator=(const REGL_Observable&) = delete;
+
+};
+
+template <typename T>
+void REGL_Observable<T>::set(const T& new_value){
+
+    // nothing to notify if unchanged
+    if (value == new_value){
+        return;
+    }
+    value = new_value;
+
+    // go by index without copying, subscriptions changed while notifying are applied afterwards
+    notifying += 1;
+    for (size_t index = 0; index < subscribers.size(); index ++){
+        if (subscribers[index].first != -1){
+            subscribers[index].second(value);
+        }
+    }
+    notifying -= 1;
+    if (notifying){
+        return;
+    }
+
+    // drop removed subscriptions and add new ones
+    subscribers.erase(
+        std::remove_if(subscribers.begin(), subscribers.end(), [](auto& subscriber){return subscriber.first == -1;}),
+        subscribers.end()
+    );
+    for (auto& subscriber: added_subscribers){
+        subscribers.push_back(std::move(subscriber));
+    }
+    added_subscribers.clear();
+
+}
+
+template <typename T>
+int REGL_Observable<T>::subscribe(std::function<void(const T&)> on_change){
+    // adding while notifying could move the function being called
+    (notifying ? added_subscribers : subscribers).push_back({next_id, on_change});
+    return next_id ++;
+}
+
+template <typename T>
+void REGL_Observable<T>::unsubscribe(int id){
+
+    auto hasId = [id](auto& subscriber){return subscriber.first == id;};
+    added_subscribers.erase(std::remove_if(added_subscribers.begin(), added_subscribers.end(), hasId), added_subscribers.end());
+
+    // the function might be running, so only mark it while notifying and remove it afterwards
+    if (notifying){
+        for (auto& subscriber: subscribers){
+            if (hasId(subscriber)){
+                subscriber.first = -1;
+            }
+        }
+        return;
+    }
+    subscribers.erase(std::remove_if(subscribers.begin(), subscribers.end(), hasId), subscribers.end());
+
+}
\ No newline at end of file
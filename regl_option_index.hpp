@@ -0,0 +1,170 @@
+#include <iostream>
+#include <vector>
+#include <string>
+#include <unordered_map>
+#include <algorithm>
+#include <iterator>
+
+#include "extern_functions.hpp"
+
+#pragma once
+
+// Index of option labels for filtering as the user types.
+// Matches are options starting with the query, sorted by label, then options containing the query, in option order.
+// Queries shorter than 3 characters only match the start of options.
+class REGL_OptionIndex{
+
+    public:
+
+        std::vector<std::string> folded; // lowercase labels
+        std::vector<int> prefix_order; // options sorted by lowercase label
+        std::unordered_map<Uint32, std::vector<int>> trigrams; // options containing each 3 character sequence, in option order
+        std::string last_query; // lowercase query of matches
+        std::vector<int> matches; // matching options of last_query
+
+        // index labels, clears matches
+        void build(const std::vector<std::string>& labels);
+
+        // get options matching a query, refines the last matches if the query only got longer
+        const std::vector<int>& filter(const std::string& query);
+
+        // get options containing all 3 character sequences of a lowercase query
+        void trigramCandidates(const std::string& folded_query, std::vector<int>& candidates);
+
+};
+
+// Lowercase ascii letters of a string.
+std::string _foldCase(const std::string& text){
+    std::string folded_text = text;
+    for (char& character: folded_text){
+        if (character >= 'A' && character <= 'Z'){
+            character += 'a' - 'A';
+        }
+    }
+    return folded_text;
+}
+
+// Key of 3 characters.
+Uint32 _trigramKey(const char* characters){
+    return (Uint32(Uint8(characters[0])) << 16) | (Uint32(Uint8(characters[1])) << 8) | Uint32(Uint8(characters[2]));
+}
+
+void REGL_OptionIndex::build(const std::vector<std::string>& labels){
+
+    folded.resize(labels.size());
+    prefix_order.resize(labels.size());
+    trigrams.clear();
+    for (size_t option = 0; option < labels.size(); option ++){
+        folded[option] = _foldCase(labels[option]);
+        prefix_order[option] = option;
+
+        // options are added in order, so each list stays sorted and only needs the last option checked for repeats
+        for (size_t position = 0; position + 3 <= folded[option].size(); position ++){
+            std::vector<int>& options = trigrams[_trigramKey(folded[option].data() + position)];
+            if (options.empty() || options.back() != int(option)){
+                options.push_back(option);
+            }
+        }
+    }
+    std::sort(prefix_order.begin(), prefix_order.end(), [this](int first, int second){
+        return folded[first] < folded[second];
+    });
+
+    // start with all options
+    last_query.clear();
+    matches.clear();
+    for (size_t option = 0; option < labels.size(); option ++){
+        matches.push_back(option);
+    }
+
+}
+
+void REGL_OptionIndex::trigramCandidates(const std::string& folded_query, std::vector<int>& candidates){
+
+    // get option lists of each sequence, no options if any sequence is in none
+    std::vector<const std::vector<int>*> lists;
+    for (size_t position = 0; position + 3 <= folded_query.size(); position ++){
+        auto found = trigrams.find(_trigramKey(folded_query.data() + position));
+        if (found == trigrams.end()){
+            candidates.clear();
+            return;
+        }
+        lists.push_back(&found->second);
+    }
+
+    // intersect from the shortest list
+    std::sort(lists.begin(), lists.end(), [](const std::vector<int>* first, const std::vector<int>* second){
+        return first->size() < second->size();
+    });
+    candidates = *lists[0];
+    std::vector<int> intersected;
+    for (size_t list = 1; list < lists.size() && !candidates.empty(); list ++){
+        intersected.clear();
+        std::set_intersection(
+            candidates.begin(), candidates.end(), lists[list]->begin(), lists[list]->end(),
+            std::back_inserter(intersected)
+        );
+        candidates.swap(intersected);
+    }
+
+}
+
+const std::vector<int>& REGL_OptionIndex::filter(const std::string& query){
+
+    std::string folded_query = _foldCase(query);
+    if (folded_query == last_query){
+        return matches;
+    }
+    auto startsWithQuery = [&folded_query, this](int option){
+        return folded[option].compare(0, folded_query.size(), folded_query) == 0;
+    };
+
+    // a longer query only matches options the shorter one matched, so only those are checked
+    if (
+        last_query.size() >= 3 && folded_query.size() > last_query.size()
+        && folded_query.compare(0, last_query.size(), last_query) == 0
+    ){
+        matches.erase(std::remove_if(matches.begin(), matches.end(), [&folded_query, this](int option){
+            return folded[option].find(folded_query) == std::string::npos;
+        }), matches.end());
+
+        // options starting with the query were sorted before, the rest go back to option order
+        auto others = std::stable_partition(matches.begin(), matches.end(), startsWithQuery);
+        std::sort(others, matches.end());
+        last_query = folded_query;
+        return matches;
+    }
+
+    // all options for an empty query
+    matches.clear();
+    if (folded_query.empty()){
+        for (size_t option = 0; option < folded.size(); option ++){
+            matches.push_back(option);
+        }
+        last_query = folded_query;
+        return matches;
+    }
+
+    // options starting with the query
+    auto first = std::lower_bound(prefix_order.begin(), prefix_order.end(), folded_query, [this](int option, const std::string& searched){
+        return folded[option] < searched;
+    });
+    for (; first != prefix_order.end() && startsWithQuery(*first); first ++){
+        matches.push_back(*first);
+    }
+
+    // options containing the query
+    if (folded_query.size() >= 3){
+        std::vector<int> candidates;
+        trigramCandidates(folded_query, candidates);
+        for (int option: candidates){
+            if (!startsWithQuery(option) && folded[option].find(folded_query) != std::string::npos){
+                matches.push_back(option);
+            }
+        }
+    }
+
+    last_query = folded_query;
+    return matches;
+
+}
\ No newline at end of file
@@ -0,0 +1,289 @@
+#include <iostream>
+#include <vector>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <atomic>
+#include <unordered_set>
+
+#include "extern_functions.hpp"
+
+#pragma once
+
+// Thread pool for work that shouldn't block the render thread.
+class REGL_ThreadPool{
+
+    public:
+
+        std::vector<std::thread> workers; // worker threads
+        std::deque<std::function<void()>> jobs; // jobs waiting for a worker
+        std::mutex jobs_mutex; // guards jobs and stopping
+        std::condition_variable jobs_condition; // wakes workers when jobs are added
+        bool stopping = false; // whether workers should exit
+
+        // add a job
+        void submit(std::function<void()> job);
+
+        // worker loop
+        void work();
+
+        // destructor
+        ~REGL_ThreadPool();
+
+        // constructor
+        REGL_ThreadPool(int thread_count);
+
+};
+
+REGL_ThreadPool::REGL_ThreadPool(int thread_count){
+    for (int index = 0; index < thread_count; index ++){
+        workers.emplace_back(&REGL_ThreadPool::work, this);
+    }
+}
+
+REGL_ThreadPool::~REGL_ThreadPool(){
+
+    // tell workers to exit
+    {
+        std::lock_guard<std::mutex> lock(jobs_mutex);
+        stopping = true;
+    }
+    jobs_condition.notify_all();
+
+    // wait for workers
+    for (std::thread& worker: workers){
+        worker.join();
+    }
+
+}
+
+void REGL_ThreadPool::submit(std::function<void()> job){
+    {
+        std::lock_guard<std::mutex> lock(jobs_mutex);
+        jobs.push_back(std::move(job));
+    }
+    jobs_condition.notify_one();
+}
+
+void REGL_ThreadPool::work(){
+    while (true){
+
+        std::function<void()> job;
+
+        // wait for a job
+        {
+            std::unique_lock<std::mutex> lock(jobs_mutex);
+            jobs_condition.wait(lock, [this]{return stopping || !jobs.empty();});
+            if (stopping && jobs.empty()){
+                return;
+            }
+            job = std::move(jobs.front());
+            jobs.pop_front();
+        }
+
+        // run job
+        job();
+
+    }
+}
+
+// Get the REGL thread pool. Workers are only started when it is first used.
+REGL_ThreadPool& reglThreadPool(){
+    static REGL_ThreadPool thread_pool(regl_max(int(std::thread::hardware_concurrency()) - 1, 1));
+    return thread_pool;
+}
+
+// Group of tasks run on the thread pool that can be waited for.
+// The waiting thread runs tasks too, so waiting never depends on busy workers.
+// Keep task groups alive for the whole program, workers might still look for tasks after waiting.
+class REGL_TaskGroup{
+
+    public:
+
+        std::deque<std::function<void()>> tasks; // tasks not started yet
+        int unfinished = 0; // tasks not finished yet
+        std::mutex tasks_mutex; // guards tasks and unfinished
+        std::condition_variable finished_condition; // notified when all tasks finished
+
+        // add a task
+        void run(std::function<void()> task);
+
+        // run a task that wasn't started yet, returns false if there are none
+        bool runNext();
+
+        // wait for all tasks
+        void wait();
+
+};
+
+void REGL_TaskGroup::run(std::function<void()> task){
+    {
+        std::lock_guard<std::mutex> lock(tasks_mutex);
+        tasks.push_back(std::move(task));
+        unfinished += 1;
+    }
+    reglThreadPool().submit([this]{runNext();});
+}
+
+bool REGL_TaskGroup::runNext(){
+
+    std::function<void()> task;
+
+    // get task
+    {
+        std::lock_guard<std::mutex> lock(tasks_mutex);
+        if (tasks.empty()){
+            return false;
+        }
+        task = std::move(tasks.front());
+        tasks.pop_front();
+    }
+
+    // run task
+    task();
+
+    // notify if all finished
+    std::lock_guard<std::mutex> lock(tasks_mutex);
+    unfinished -= 1;
+    if (!unfinished){
+        finished_condition.notify_all();
+    }
+
+    return true;
+
+}
+
+void REGL_TaskGroup::wait(){
+
+    // help with tasks
+    while (runNext());
+
+    // wait for tasks running on workers
+    std::unique_lock<std::mutex> lock(tasks_mutex);
+    finished_condition.wait(lock, [this]{return !unfinished;});
+
+}
+
+// Command posted to the command queue.
+class _Command{
+
+    public:
+
+        std::atomic<_Command*> next; // next command in the queue
+        const void* key; // commands with the same key replace each other, NULL if never replaced
+        std::function<void()> function; // function to run
+
+        // constructor
+        _Command(const void* key, std::function<void()> function) : next(NULL){this->key = key; this->function = std::move(function);};
+
+};
+
+// Lock free queue of commands. Any thread can post, only the render thread runs them.
+// Posting doesn't take a lock, but allocates the command and its function.
+class REGL_CommandQueue{
+
+    public:
+
+        std::atomic<_Command*> head; // last posted command
+        _Command* tail; // next command to run
+        _Command stub; // placeholder so the queue is never empty
+        std::vector<_Command*> drained; // commands taken out of the queue, reused between runs
+        std::unordered_set<const void*> seen_keys; // keys seen while coalescing, reused between runs
+
+        // post a command, safe from any thread
+        void post(const void* key, std::function<void()> function);
+
+        // take the next command out of the queue, NULL if empty
+        _Command* pop();
+
+        // run all posted commands, only the newest command of each key is run
+        void run();
+
+        // destructor
+        ~REGL_CommandQueue();
+
+        // constructor
+        REGL_CommandQueue() : head(&stub), stub(NULL, NULL){tail = &stub;};
+
+};
+
+void REGL_CommandQueue::post(const void* key, std::function<void()> function){
+    _Command* command = new _Command(key, std::move(function));
+    _Command* previous = head.exchange(command, std::memory_order_acq_rel);
+    previous->next.store(command, std::memory_order_release);
+}
+
+_Command* REGL_CommandQueue::pop(){
+
+    _Command* first = tail;
+    _Command* next = first->next.load(std::memory_order_acquire);
+
+    // skip stub
+    if (first == &stub){
+        if (!next){
+            return NULL;
+        }
+        tail = next;
+        first = next;
+        next = next->next.load(std::memory_order_acquire);
+    }
+
+    // more commands after this one
+    if (next){
+        tail = next;
+        return first;
+    }
+
+    // a command is being posted, get it next time
+    if (first != head.load(std::memory_order_acquire)){
+        return NULL;
+    }
+
+    // put stub back so the last command can be taken out
+    stub.next.store(NULL, std::memory_order_relaxed);
+    _Command* previous = head.exchange(&stub, std::memory_order_acq_rel);
+    previous->next.store(&stub, std::memory_order_release);
+    next = first->next.load(std::memory_order_acquire);
+    if (next){
+        tail = next;
+        return first;
+    }
+    return NULL;
+
+}
+
+void REGL_CommandQueue::run(){
+
+    // take commands out of the queue
+    drained.clear();
+    while (_Command* command = pop()){
+        drained.push_back(command);
+    }
+
+    // drop commands replaced by newer ones with the same key
+    seen_keys.clear();
+    for (int index = drained.size() - 1; index != -1; index --){
+        const void* key = drained[index]->key;
+        if (key && !seen_keys.insert(key).second){
+            delete drained[index];
+            drained[index] = NULL;
+        }
+    }
+
+    // run in order
+    for (_Command* command: drained){
+        if (command){
+            command->function();
+            delete command;
+        }
+    }
+
+}
+
+REGL_CommandQueue::~REGL_CommandQueue(){
+    while (_Command* command = pop()){
+        delete command;
+    }
+}
\ No newline at end of file
@@ -1,38 +1,456 @@
 #include <iostream>
 #include <unordered_map>
+#include <unordered_set>
+#include <list>
+#include <vector>
+#include <mutex>
+#include <iterator>
 
 #include "color.hpp"
 #include "regl_defaults.hpp"
+#include "regl_threads.hpp"
 
 #include "SDL2/include/SDL2/SDL.h"
 #include "SDL2/include/SDL2/SDL_image.h"
 
 #pragma once
 
-std::unordered_map<std::string, SDL_Texture*> _cached_textures;
 SDL_Texture* _circle_texture;
 
+// Texture stored in the texture cache.
+class _CachedTexture{
+
+    public:
+
+        std::string path; // path the texture was loaded from
+        SDL_Texture* texture; // texture
+        size_t bytes; // texture memory
+        int references = 0; // number of handles using this texture
+        Uint64 inserted_frame = 0; // frame the texture was added in, it isn't evicted in that frame
+        std::list<_CachedTexture*>::iterator lru_position; // position in the lru list
+
+};
+
+// Texture cache with a byte budget. Least recently used textures are evicted first, textures in use or added this frame are never evicted.
+class REGL_TextureCache{
+
+    public:
+
+        std::unordered_map<std::string, _CachedTexture> textures; // cached textures
+        std::list<_CachedTexture*> lru; // most recently used textures at the front
+        std::unordered_set<std::string> failed_paths; // paths that couldn't be loaded
+        size_t bytes = 0; // memory used by cached textures
+        size_t hits = 0; // lookups that found a texture
+        size_t misses = 0; // loads started because a texture wasn't cached
+        size_t evictions = 0; // textures evicted
+        Uint64 frame = 0; // current frame, textures added in it aren't evicted before objects can take handles to them
+
+        // find a texture, NULL if not cached
+        _CachedTexture* find(std::string path);
+
+        // add a texture, returns the cached one if already cached and NULL if the texture is NULL
+        _CachedTexture* insert(std::string path, SDL_Texture* texture);
+
+        // evict least recently used textures until under budget
+        void evict(size_t budget = REGL_TEXTURE_CACHE_BUDGET);
+
+};
+
+_CachedTexture* REGL_TextureCache::find(std::string path){
+
+    auto found = textures.find(path);
+    if (found == textures.end()){
+        return NULL;
+    }
+    hits += 1;
+
+    // move to front of lru list
+    lru.splice(lru.begin(), lru, found->second.lru_position);
+
+    return &found->second;
+
+}
+
+_CachedTexture* REGL_TextureCache::insert(std::string path, SDL_Texture* texture){
+
+    // remember textures that couldn't be created
+    if (!texture){
+        std::cout << "Unable to create texture: " << SDL_GetError() << "\n";
+        failed_paths.insert(path);
+        return NULL;
+    }
+
+    // keep the cached texture
+    auto found = textures.find(path);
+    if (found != textures.end()){
+        SDL_DestroyTexture(texture);
+        return &found->second;
+    }
+
+    // get texture memory
+    Uint32 format;
+    int width, height;
+    SDL_QueryTexture(texture, &format, NULL, &width, &height);
+
+    // add texture
+    _CachedTexture& cached_texture = textures[path];
+    cached_texture.path = path;
+    cached_texture.texture = texture;
+    cached_texture.bytes = size_t(width) * height * SDL_BYTESPERPIXEL(format);
+    cached_texture.inserted_frame = frame;
+    lru.push_front(&cached_texture);
+    cached_texture.lru_position = lru.begin();
+    bytes += cached_texture.bytes;
+
+    // make space, the new texture isn't evicted this frame
+    evict();
+
+    return &cached_texture;
+
+}
+
+void REGL_TextureCache::evict(size_t budget){
+
+    auto lru_position = lru.end();
+    while (bytes > budget && lru_position != lru.begin()){
+
+        lru_position --;
+
+        // don't evict textures in use or added this frame
+        _CachedTexture* cached_texture = *lru_position;
+        if (cached_texture->references || cached_texture->inserted_frame == frame){
+            continue;
+        }
+
+        // destroy texture
+        bytes -= cached_texture->bytes;
+        evictions += 1;
+        SDL_DestroyTexture(cached_texture->texture);
+        lru_position = lru.erase(lru_position);
+        std::string path = cached_texture->path;
+        textures.erase(path);
+
+    }
+
+}
+
+REGL_TextureCache regl_texture_cache;
+
+// Handle to a texture in the texture cache. The texture isn't evicted while a handle to it exists.
+class REGL_TextureHandle{
+
+    public:
+
+        _CachedTexture* cached_texture = NULL; // cached texture, NULL if not cached
+        SDL_Texture* texture = NULL; // texture, can be a placeholder if not cached
+
+        // get texture
+        SDL_Texture* get(){return texture;};
+
+        // assignment
+        REGL_TextureHandle& operator=(const REGL_TextureHandle& other);
+
+        // destructor
+        ~REGL_TextureHandle(){release();};
+
+        // release texture
+        void release();
+
+        // constructors
+        REGL_TextureHandle(_CachedTexture* cached_texture);
+        REGL_TextureHandle(SDL_Texture* texture){this->texture = texture;};
+        REGL_TextureHandle(const REGL_TextureHandle& other) : REGL_TextureHandle(other.cached_texture){texture = other.texture;};
+        REGL_TextureHandle() = default;
+
+};
+
+REGL_TextureHandle::REGL_TextureHandle(_CachedTexture* cached_texture){
+    this->cached_texture = cached_texture;
+    if (cached_texture){
+        texture = cached_texture->texture;
+        cached_texture->references += 1;
+    }
+}
+
+REGL_TextureHandle& REGL_TextureHandle::operator=(const REGL_TextureHandle& other){
+    if (other.cached_texture){
+        other.cached_texture->references += 1;
+    }
+    release();
+    cached_texture = other.cached_texture;
+    texture = other.texture;
+    return *this;
+}
+
+void REGL_TextureHandle::release(){
+
+    if (cached_texture){
+        cached_texture->references -= 1;
+
+        // evict now if the cache went over budget while this was in use
+        if (!cached_texture->references){
+            cached_texture = NULL;
+            regl_texture_cache.evict();
+        }
+    }
+    cached_texture = NULL;
+    texture = NULL;
+
+}
+
+// Image decoded on a worker thread.
+class _DecodedImage{
+
+    public:
+
+        std::string path; // cache key
+        SDL_Surface* surface; // decoded surface, NULL if decoding failed
+        std::string decoding_key; // removed from the images being decoded when uploaded, empty if none
+        std::string mips_key; // key of the mip levels this is a level of, empty if not a mip level
+        SDL_Point image_size = {0, 0}; // size of level 0 of the mip levels, {0, 0} if unknown
+
+};
+
+// Images decoded on worker threads, waiting to be uploaded on the render thread.
+std::vector<_DecodedImage> _decoded_images;
+std::mutex _decoded_images_mutex;
+std::unordered_set<std::string> _decoding_images;
+
+// Size of level 0 of images loaded with mip levels, by mips key. Only used on the render thread.
+std::unordered_map<std::string, SDL_Point> _mip_image_sizes;
+
 // Load a texture and cache it.
-SDL_Texture* loadTexture(SDL_Renderer* renderer, std::string path){
+REGL_TextureHandle loadTexture(SDL_Renderer* renderer, std::string path){
+
+    _CachedTexture* cached_texture = regl_texture_cache.find(path);
+    if (cached_texture){
+        return REGL_TextureHandle(cached_texture);
+    }
 
-    if (_cached_textures.count(path) != 0){
-        return _cached_textures[path];
+    // don't retry images that failed
+    if (regl_texture_cache.failed_paths.count(path) != 0){
+        return REGL_TextureHandle();
     }
 
+    regl_texture_cache.misses += 1;
     SDL_Surface* temp_surface = IMG_Load(path.c_str());
 
     if (!temp_surface){
         std::cout << "Unable to load image: " << SDL_GetError() << "\n";
+        regl_texture_cache.failed_paths.insert(path);
+        return REGL_TextureHandle();
     }
 
     SDL_Texture* loaded_texture = SDL_CreateTextureFromSurface(renderer, temp_surface);
     SDL_FreeSurface(temp_surface);
 
     // cache texture
-    _cached_textures[path] = loaded_texture;
+    return REGL_TextureHandle(regl_texture_cache.insert(path, loaded_texture));
+
+}
+
+// Load a texture in the background and cache it. Returns the placeholder until it is uploaded.
+REGL_TextureHandle loadTextureAsync(SDL_Renderer* renderer, std::string path, SDL_Texture* placeholder = NULL){
+
+    _CachedTexture* cached_texture = regl_texture_cache.find(path);
+    if (cached_texture){
+        return REGL_TextureHandle(cached_texture);
+    }
+
+    // start decoding if not decoding already
+    if (_decoding_images.count(path) == 0 && regl_texture_cache.failed_paths.count(path) == 0){
+        _decoding_images.insert(path);
+        regl_texture_cache.misses += 1;
+        reglThreadPool().submit([path]{
+
+            // decode and convert to the texture format on the worker
+            SDL_Surface* decoded_surface = IMG_Load(path.c_str());
+            if (decoded_surface){
+                SDL_Surface* converted_surface = SDL_ConvertSurfaceFormat(decoded_surface, SDL_PIXELFORMAT_ARGB8888, 0);
+                SDL_FreeSurface(decoded_surface);
+                decoded_surface = converted_surface;
+            } else {
+                std::cout << "Unable to load image: " << IMG_GetError() << "\n";
+            }
+
+            // hand over to the render thread
+            std::lock_guard<std::mutex> lock(_decoded_images_mutex);
+            _decoded_images.push_back({path, decoded_surface, path, "", {0, 0}});
+
+        });
+    }
+
+    return REGL_TextureHandle(placeholder);
+
+}
+
+// Get cache key of a mip level of an image, level 0 is the image itself.
+std::string mipPath(std::string path, int level){
+    return (level) ? path + "#mip" + std::to_string(level) : path;
+}
 
-    // return texture
-    return loaded_texture;
+// Get number of mip levels of an image, the last level is 1x1.
+int mipLevelCount(int width, int height){
+    int level_count = 1;
+    while ((width > 1 || height > 1) && level_count < 16){
+        width = regl_max(width / 2, 1);
+        height = regl_max(height / 2, 1);
+        level_count += 1;
+    }
+    return level_count;
+}
+
+// Downscale an ARGB8888 surface to half its size, averaging each 2x2 block weighted by alpha.
+SDL_Surface* boxDownscale(SDL_Surface* surface){
+
+    int width = regl_max(surface->w / 2, 1);
+    int height = regl_max(surface->h / 2, 1);
+    SDL_Surface* downscaled_surface = SDL_CreateRGBSurfaceWithFormat(0, width, height, 32, SDL_PIXELFORMAT_ARGB8888);
+    if (!downscaled_surface){
+        return NULL;
+    }
+
+    for (int y = 0; y < height; y ++){
+        Uint32* row_pixels[2] = {
+            (Uint32*) ((Uint8*) surface->pixels + regl_min(y * 2, surface->h - 1) * surface->pitch),
+            (Uint32*) ((Uint8*) surface->pixels + regl_min(y * 2 + 1, surface->h - 1) * surface->pitch)
+        };
+        Uint32* downscaled_pixels = (Uint32*) ((Uint8*) downscaled_surface->pixels + y * downscaled_surface->pitch);
+        for (int x = 0; x < width; x ++){
+
+            // weight colors by alpha so transparent pixels don't darken edges
+            Uint32 alpha = 0, red = 0, green = 0, blue = 0;
+            for (int sample = 0; sample < 4; sample ++){
+                Uint32 pixel = row_pixels[sample / 2][regl_min(x * 2 + sample % 2, surface->w - 1)];
+                Uint32 pixel_alpha = pixel >> 24;
+                alpha += pixel_alpha;
+                red += ((pixel >> 16) & 0xFF) * pixel_alpha;
+                green += ((pixel >> 8) & 0xFF) * pixel_alpha;
+                blue += (pixel & 0xFF) * pixel_alpha;
+            }
+            downscaled_pixels[x] = (alpha) ? ((alpha / 4) << 24) | ((red / alpha) << 16) | ((green / alpha) << 8) | (blue / alpha) : 0;
+
+        }
+    }
+
+    return downscaled_surface;
+
+}
+
+// Load a texture and its box filtered mip levels in the background, each level is half the size of the one before.
+// Levels that are still cached aren't uploaded again. Returns false if the image couldn't be decoded.
+bool loadMipTexturesAsync(SDL_Renderer* renderer, std::string path){
+
+    // start decoding all levels if not decoding already
+    std::string mips_key = path + "#mips";
+    if (regl_texture_cache.failed_paths.count(mips_key) != 0){
+        return false;
+    }
+    if (_decoding_images.count(mips_key) == 0){
+        _decoding_images.insert(mips_key);
+        regl_texture_cache.misses += 1;
+        reglThreadPool().submit([path, mips_key]{
+
+            // decode and convert to the texture format on the worker
+            SDL_Surface* decoded_surface = IMG_Load(path.c_str());
+            if (decoded_surface){
+                SDL_Surface* converted_surface = SDL_ConvertSurfaceFormat(decoded_surface, SDL_PIXELFORMAT_ARGB8888, 0);
+                SDL_FreeSurface(decoded_surface);
+                decoded_surface = converted_surface;
+            } else {
+                std::cout << "Unable to load image: " << IMG_GetError() << "\n";
+            }
+            if (!decoded_surface){
+                std::lock_guard<std::mutex> lock(_decoded_images_mutex);
+                _decoded_images.push_back({path, NULL, mips_key, mips_key, {0, 0}});
+                return;
+            }
+
+            // downscale each level from the one before, a level that fails fails all smaller levels
+            std::vector<SDL_Surface*> levels = {decoded_surface};
+            int level_count = mipLevelCount(decoded_surface->w, decoded_surface->h);
+            while (int(levels.size()) < level_count){
+                levels.push_back((levels.back()) ? boxDownscale(levels.back()) : NULL);
+            }
+
+            // hand over to the render thread, the last level finishes decoding
+            SDL_Point image_size = {decoded_surface->w, decoded_surface->h};
+            std::lock_guard<std::mutex> lock(_decoded_images_mutex);
+            for (size_t level = 0; level < levels.size(); level ++){
+                _decoded_images.push_back({
+                    mipPath(path, level), levels[level], (level + 1 == levels.size()) ? mips_key : "", mips_key, image_size
+                });
+            }
+
+        });
+    }
+
+    return true;
+
+}
+
+// Upload images decoded in the background, at most REGL_TEXTURE_UPLOAD_BUDGET bytes per call. Call once per frame, it starts a new frame of the texture cache.
+void uploadDecodedImages(SDL_Renderer* renderer){
+
+    // textures uploaded from now on are kept until the next call
+    regl_texture_cache.frame += 1;
+
+    // take the images of this call, workers can keep handing over images while they are uploaded
+    std::vector<_DecodedImage> decoded_images;
+    {
+        std::lock_guard<std::mutex> lock(_decoded_images_mutex);
+
+        // stop if over budget, always take at least one
+        size_t taken_count = 0;
+        int taken_bytes = 0;
+        for (; taken_count < _decoded_images.size(); taken_count ++){
+            SDL_Surface* decoded_surface = _decoded_images[taken_count].surface;
+            int surface_bytes = (decoded_surface) ? decoded_surface->h * decoded_surface->pitch : 0;
+            if (taken_count && taken_bytes + surface_bytes > REGL_TEXTURE_UPLOAD_BUDGET){
+                break;
+            }
+            taken_bytes += surface_bytes;
+        }
+        decoded_images.assign(
+            std::make_move_iterator(_decoded_images.begin()), std::make_move_iterator(_decoded_images.begin() + taken_count)
+        );
+        _decoded_images.erase(_decoded_images.begin(), _decoded_images.begin() + taken_count);
+    }
+
+    for (_DecodedImage& decoded_image: decoded_images){
+
+        std::string& path = decoded_image.path;
+        SDL_Surface* decoded_surface = decoded_image.surface;
+        if (!decoded_image.decoding_key.empty()){
+            _decoding_images.erase(decoded_image.decoding_key);
+        }
+
+        // remember the size of mip levels
+        if (!decoded_image.mips_key.empty() && decoded_image.image_size.x){
+            _mip_image_sizes[decoded_image.mips_key] = decoded_image.image_size;
+        }
+
+        // remember failed images, and images whose mip levels couldn't be decoded at all
+        if (!decoded_surface){
+            regl_texture_cache.failed_paths.insert(path);
+            if (!decoded_image.mips_key.empty() && !decoded_image.image_size.x){
+                regl_texture_cache.failed_paths.insert(decoded_image.mips_key);
+            }
+            continue;
+        }
+
+        // skip textures that are still cached, like mip levels that weren't evicted
+        if (regl_texture_cache.textures.count(path)){
+            SDL_FreeSurface(decoded_surface);
+            continue;
+        }
+
+        // upload and cache texture
+        SDL_Texture* loaded_texture = SDL_CreateTextureFromSurface(renderer, decoded_surface);
+        SDL_FreeSurface(decoded_surface);
+        regl_texture_cache.insert(path, loaded_texture);
+
+    }
 
 }
 
@@ -71,6 +489,134 @@ void SDL_FillIncludeRect(SDL_Renderer* renderer, SDL_Rect original_rect, SDL_Rec
     }
 }
 
+// Mip levels of an image, drawn at the level closest to the size they are drawn at.
+// Only the drawn level and the next larger one are kept, the other levels can be evicted and are found again in the texture cache.
+class REGL_MipTexture{
+
+    public:
+
+        std::string path; // image path
+        SDL_Point image_size = {0, 0}; // size of level 0, {0, 0} until known
+        std::vector<REGL_TextureHandle> levels; // kept levels, the others are empty
+        int drawn_level = -1; // level drawn last, -1 if none
+        int settled_level = -1; // level wanted for the size drawn at, when drawn_level is the best loadable level for it
+        bool failed = false; // whether the image couldn't be decoded
+
+        // start loading the levels in the background, returns whether the size of the image is known
+        bool load(SDL_Renderer* renderer);
+
+        // render the level closest to the size of a rect, cropped to include_rect, levels are loaded in the background
+        void render(SDL_Renderer* renderer, SDL_Rect original_rect, SDL_Rect include_rect, REGL_Color color = REGL_COLOR_WHITE);
+
+        // pick the level to draw for a wanted level and keep it
+        void pickLevel(SDL_Renderer* renderer, int wanted_level);
+
+        // constructor
+        REGL_MipTexture(std::string path = ""){this->path = path;};
+
+};
+
+void REGL_MipTexture::pickLevel(SDL_Renderer* renderer, int wanted_level){
+
+    // levels that failed, like ones over the maximum texture size, are replaced by the closest larger level
+    int best_level = wanted_level;
+    while (best_level > 0 && regl_texture_cache.failed_paths.count(mipPath(path, best_level))){
+        best_level -= 1;
+    }
+
+    // draw the best level, otherwise the closest loaded larger level, otherwise the closest loaded smaller level
+    drawn_level = -1;
+    for (int step = 0; step < int(levels.size()) && drawn_level == -1; step ++){
+        int level = (step <= best_level) ? best_level - step : step;
+        if (!levels[level].get()){
+            levels[level] = REGL_TextureHandle(regl_texture_cache.find(mipPath(path, level)));
+        }
+        if (levels[level].get()){
+            drawn_level = level;
+        }
+    }
+
+    // load levels again if the best level was evicted, done once it is drawn
+    if (drawn_level == best_level || regl_texture_cache.failed_paths.count(mipPath(path, best_level))){
+        settled_level = wanted_level;
+    } else {
+        loadMipTexturesAsync(renderer, path);
+    }
+
+    // keep the drawn level and the next larger one, let the others be evicted
+    for (int level = 0; level < int(levels.size()); level ++){
+        if (level == drawn_level - 1 && !levels[level].get()){
+            levels[level] = REGL_TextureHandle(regl_texture_cache.find(mipPath(path, level)));
+        } else if (level != drawn_level && level != drawn_level - 1){
+            levels[level].release();
+        }
+    }
+
+}
+
+bool REGL_MipTexture::load(SDL_Renderer* renderer){
+
+    if (image_size.x || failed){
+        return image_size.x;
+    }
+
+    // load until the size of the image is known
+    auto found = _mip_image_sizes.find(path + "#mips");
+    if (found == _mip_image_sizes.end()){
+        failed = !loadMipTexturesAsync(renderer, path);
+        return false;
+    }
+    image_size = found->second;
+    levels.resize(mipLevelCount(image_size.x, image_size.y));
+    return true;
+
+}
+
+void REGL_MipTexture::render(SDL_Renderer* renderer, SDL_Rect original_rect, SDL_Rect include_rect, REGL_Color color){
+
+    if (original_rect.w <= 0 || original_rect.h <= 0 || !load(renderer)){
+        return;
+    }
+
+    // smallest level that isn't smaller than the rect
+    int wanted_level = 0;
+    while (
+        wanted_level + 1 < int(levels.size())
+        && (image_size.x >> (wanted_level + 1)) >= original_rect.w && (image_size.y >> (wanted_level + 1)) >= original_rect.h
+    ){
+        wanted_level += 1;
+    }
+    if (wanted_level != settled_level){
+        pickLevel(renderer, wanted_level);
+    }
+    if (drawn_level == -1){
+        return;
+    }
+    SDL_Texture* level_texture = levels[drawn_level].get();
+    int level_width = regl_max(image_size.x >> drawn_level, 1);
+    int level_height = regl_max(image_size.y >> drawn_level, 1);
+
+    // crop rect
+    SDL_Rect cropped_rect = getIncludeCrop(original_rect, include_rect);
+    if (!cropped_rect.w || !cropped_rect.h){
+        return;
+    }
+    SDL_Rect render_rect = {
+        original_rect.x + cropped_rect.x, original_rect.y + cropped_rect.y,
+        cropped_rect.w, cropped_rect.h
+    };
+
+    // scale crop rect to the level
+    cropped_rect.x = cropped_rect.x * level_width / original_rect.w;
+    cropped_rect.y = cropped_rect.y * level_height / original_rect.h;
+    cropped_rect.w = cropped_rect.w * level_width / original_rect.w;
+    cropped_rect.h = cropped_rect.h * level_height / original_rect.h;
+
+    SDL_SetTextureColorMod(level_texture, color.r, color.g, color.b);
+    SDL_RenderCopy(renderer, level_texture, &cropped_rect, &render_rect);
+
+}
+
 // Fill a circle. Code formatted from: https://gist.github.com/Gumichan01/332c26f6197a432db91cc4327fcabb1c
 void SDL_RenderFillCircle(SDL_Renderer* renderer, int x, int y, int radius, REGL_Color color){
 